@@ -0,0 +1,213 @@
+#include <algorithm>
+#include <chrono>
+#include <random>
+
+#include "AlphaBetaPolicy.h"
+#include "ModelBuilder.h"
+
+AlphaBetaPolicy::AlphaBetaPolicy(unsigned int seed, int maxDepth, unsigned int milliseconds) :
+    seed(seed),
+    maxDepth(maxDepth),
+    milliseconds(milliseconds),
+    table(TRANSPOSITION_TABLE_BITS),
+    rootPlayer(0),
+    rootMove(),
+    nodes(0),
+    aborted(false),
+    completedDepth(0)
+{}
+
+Move AlphaBetaPolicy::chooseMove(GameModel& gameModel, Move* moves, unsigned int numberOfMoves) {
+    // Search a copy, as refills shuffle the bag
+    GameState rootState;
+    gameModel.saveState(rootState);
+
+    GameModel searchModel;
+    ModelBuilder(searchModel).loadState(rootState);
+    GameRules rules(searchModel);
+    MoveGenerator moveGenerator(searchModel);
+
+    // Values are for the root player, so results from an earlier search
+    // may be for someone else
+    table.clear();
+
+    rootPlayer = searchModel.getCurrentPlayerIndex();
+    nodes = 0;
+    aborted = false;
+    completedDepth = 0;
+    deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(milliseconds);
+
+    Move best = moves[0];
+
+    for (int depth = 1; depth <= maxDepth && !aborted; ++depth) {
+        rootMove = Move();
+        search(searchModel, rules, moveGenerator, depth, 0, -ALPHA_BETA_INFINITY, ALPHA_BETA_INFINITY);
+
+        // An unfinished search is only as good as the moves it has seen
+        if (!aborted && rootMove.isValid()) {
+            best = rootMove;
+            completedDepth = depth;
+        }
+    }
+
+    return best;
+}
+
+unsigned long AlphaBetaPolicy::getNodes() {
+    return nodes;
+}
+
+int AlphaBetaPolicy::getCompletedDepth() {
+    return completedDepth;
+}
+
+int AlphaBetaPolicy::search(GameModel& gameModel, GameRules& rules, MoveGenerator& moveGenerator,
+                            int depth, int ply, int alpha, int beta) {
+    int result = 0;
+    ++nodes;
+
+    // Checking the clock is slow, so only do so every so often
+    if (milliseconds != 0 && (nodes & 0x3FF) == 0 && std::chrono::steady_clock::now() > deadline) {
+        aborted = true;
+    }
+
+    Move moves[MAX_MOVES];
+    unsigned int numberOfMoves = 0;
+
+    if (!aborted && depth != 0) {
+        numberOfMoves = moveGenerator.generateDistinct(moves);
+    }
+
+    if (aborted) {
+        result = 0;
+    } else if (numberOfMoves == 0) {
+        result = evaluate(gameModel);
+    } else {
+        uint64_t key = gameModel.getCanonicalHash();
+        TableEntry entry;
+        Move tableMove;
+        bool cutoff = false;
+
+        if (table.probe(key, entry)) {
+            tableMove = entry.move;
+
+            // The root always searches, so that it has a move to return
+            if (entry.depth >= depth && ply != 0) {
+                if (entry.bound == BOUND_EXACT) {
+                    result = entry.value;
+                    cutoff = true;
+                } else if (entry.bound == BOUND_LOWER && entry.value >= beta) {
+                    result = entry.value;
+                    cutoff = true;
+                } else if (entry.bound == BOUND_UPPER && entry.value <= alpha) {
+                    result = entry.value;
+                    cutoff = true;
+                }
+            }
+        }
+
+        if (!cutoff) {
+            bool maximising = gameModel.getCurrentPlayerIndex() == rootPlayer;
+            int originalAlpha = alpha;
+            int originalBeta = beta;
+            int best = maximising ? -ALPHA_BETA_INFINITY : ALPHA_BETA_INFINITY;
+            Move bestMove = moves[0];
+
+            moveGenerator.order(moves, numberOfMoves, tableMove);
+
+            for (unsigned int i = 0; i != numberOfMoves && alpha < beta && !aborted; ++i) {
+                int value = 0;
+
+                if (rules.endsRound(moves[i])) {
+                    value = searchChance(gameModel, rules, moveGenerator, moves[i], depth, ply);
+                } else {
+                    rules.applyMove(moves[i]);
+                    value = search(gameModel, rules, moveGenerator, depth - 1, ply + 1, alpha, beta);
+                    rules.undoMove();
+                }
+
+                if (maximising ? value > best : value < best) {
+                    best = value;
+                    bestMove = moves[i];
+                }
+
+                if (maximising) {
+                    alpha = std::max(alpha, best);
+                } else {
+                    beta = std::min(beta, best);
+                }
+            }
+
+            if (!aborted) {
+                entry.value = best;
+                entry.depth = depth;
+                entry.move = bestMove;
+                if (best <= originalAlpha) {
+                    entry.bound = BOUND_UPPER;
+                } else if (best >= originalBeta) {
+                    entry.bound = BOUND_LOWER;
+                } else {
+                    entry.bound = BOUND_EXACT;
+                }
+                table.store(key, entry);
+
+                if (ply == 0) {
+                    rootMove = bestMove;
+                }
+            }
+
+            result = best;
+        }
+    }
+
+    return result;
+}
+
+int AlphaBetaPolicy::searchChance(GameModel& gameModel, GameRules& rules, MoveGenerator& moveGenerator,
+                                  Move move, int depth, int ply) {
+    int total = 0;
+    int samples = 0;
+    bool sampling = true;
+    uint64_t key = gameModel.getHash() ^ move.getValue();
+
+    while (sampling && !aborted) {
+        // The same position always draws the same refills
+        std::mt19937 engine((unsigned int) (key ^ (key >> 32)) ^ (seed + samples * 2654435761u));
+        gameModel.getTileBag()->shuffle(engine);
+        gameModel.getBoxLid()->shuffle(engine);
+
+        MoveResult result = rules.applyMove(move);
+
+        if (result == GAME_OVER || depth == 1) {
+            // The refill makes no difference to the score
+            total += evaluate(gameModel);
+            sampling = false;
+        } else {
+            total += search(gameModel, rules, moveGenerator, depth - 1, ply + 1,
+                            -ALPHA_BETA_INFINITY, ALPHA_BETA_INFINITY);
+        }
+
+        rules.undoMove();
+        ++samples;
+
+        if (samples == ALPHA_BETA_CHANCE_SAMPLES) {
+            sampling = false;
+        }
+    }
+
+    return total / samples;
+}
+
+int AlphaBetaPolicy::evaluate(GameModel& gameModel) {
+    GameRules rules(gameModel);
+    int rootScore = rules.getProjectedScore(rootPlayer);
+    int bestOther = -ALPHA_BETA_INFINITY;
+
+    for (int i = 0; i != gameModel.getNumberOfPlayers(); ++i) {
+        if (i != rootPlayer) {
+            bestOther = std::max(bestOther, rules.getProjectedScore(i));
+        }
+    }
+
+    return rootScore - bestOther;
+}
@@ -0,0 +1,80 @@
+/*
+ * Alpha-Beta Policy
+ * 
+ * Depth limited search of the factory offer, using alpha-beta with
+ * iterative deepening and a transposition table. With more than 2 players
+ * the search is paranoid: every other player is assumed to play against
+ * the player choosing the move.
+ * 
+ * Leaves are scored as if the round ended there, as the player's projected
+ * score less the best projected score of the rest. A move that ends the
+ * round leads to a chance node, averaged over a few refills of the
+ * factories, each drawn from a bag shuffled by a generator seeded from the
+ * position. With no time limit the search is fully reproducible.
+ * 
+ * Authors: C. Hodgen (s3031209), J. Osrecak (s3782455)
+ */
+
+#ifndef ALPHA_BETA_POLICY_H
+#define ALPHA_BETA_POLICY_H
+
+#include <chrono>
+#include <cstdint>
+
+#include "GameModel.h"
+#include "GameRules.h"
+#include "MoveGenerator.h"
+#include "Policy.h"
+#include "TranspositionTable.h"
+
+// Depth searched when none is given
+#define ALPHA_BETA_DEFAULT_DEPTH    3
+
+// Refills sampled at each chance node
+#define ALPHA_BETA_CHANCE_SAMPLES   2
+
+// Larger than any score difference
+#define ALPHA_BETA_INFINITY         30000
+
+class AlphaBetaPolicy : public Policy {
+    public:
+        // A time limit of 0 is no limit, so the full depth is always searched
+        AlphaBetaPolicy(unsigned int seed, int maxDepth, unsigned int milliseconds);
+
+        Move chooseMove(GameModel& gameModel, Move* moves, unsigned int numberOfMoves);
+
+        // Positions visited by the last search
+        unsigned long getNodes();
+
+        // Deepest search completed by the last search
+        int getCompletedDepth();
+
+    private:
+        unsigned int seed;
+        int maxDepth;
+        unsigned int milliseconds;
+
+        TranspositionTable table;
+
+        // State of the current search
+        int rootPlayer;
+        Move rootMove;
+        unsigned long nodes;
+        bool aborted;
+        int completedDepth;
+        std::chrono::steady_clock::time_point deadline;
+
+        // Value of the position for the root player, searching depth moves
+        // ahead. ply is the distance from the root.
+        int search(GameModel& gameModel, GameRules& rules, MoveGenerator& moveGenerator,
+                   int depth, int ply, int alpha, int beta);
+
+        // Value of a move that ends the round, averaged over sampled refills
+        int searchChance(GameModel& gameModel, GameRules& rules, MoveGenerator& moveGenerator,
+                         Move move, int depth, int ply);
+
+        // Projected score of the root player less the best of the rest
+        int evaluate(GameModel& gameModel);
+};
+
+#endif // ALPHA_BETA_POLICY_H
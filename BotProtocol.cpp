@@ -0,0 +1,516 @@
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+#include "AlphaBetaPolicy.h"
+#include "BotProtocol.h"
+#include "CompactSave.h"
+#include "GameRules.h"
+#include "MctsPolicy.h"
+#include "ModelBuilder.h"
+#include "MoveGenerator.h"
+
+using std::make_shared;
+using std::shared_ptr;
+using std::string;
+using std::to_string;
+using std::vector;
+
+BotProtocol::BotProtocol() :
+    gameModel(make_shared<GameModel>()),
+    havePosition(false),
+    seed(std::random_device()()),
+    inputStart(0),
+    policy(nullptr)
+{}
+
+void BotProtocol::setSeed(int seed) {
+    this->seed = seed;
+}
+
+void BotProtocol::run() {
+    string line;
+    string output;
+    bool running = true;
+
+    while (running && readLine(line)) {
+        if (line.find_first_not_of(" \t\r") != string::npos) {
+            running = handle(line, output);
+            running = writeAll(output) && running;
+        }
+    }
+}
+
+bool BotProtocol::handle(const string& line, string& output) {
+    bool running = true;
+    string error;
+    bool valid = request.parse(line, error);
+
+    output.assign(1, '{');
+
+    if (valid && request.has("id")) {
+        JsonMessage::appendKey(output, "id");
+        output += request.getRaw("id");
+    }
+
+    // Replaced by the error if the command fails
+    size_t mark = output.size();
+    JsonMessage::appendKey(output, "ok");
+    output += "true";
+
+    if (valid) {
+        string command = request.getString("cmd", "");
+
+        if (command == "hello") {
+            JsonMessage::appendKey(output, "protocol");
+            JsonMessage::appendString(output, PROTOCOL_NAME);
+            JsonMessage::appendKey(output, "version");
+            output += to_string(PROTOCOL_VERSION);
+        } else if (command == "isready") {
+            JsonMessage::appendKey(output, "ready");
+            output += "true";
+        } else if (command == "position") {
+            valid = setPosition(output, error);
+        } else if (command == "moves") {
+            valid = requirePosition(error) && listMoves(output, error);
+        } else if (command == "play") {
+            valid = requirePosition(error) && playMove(output, error);
+        } else if (command == "go") {
+            valid = requirePosition(error) && think(output, error);
+        } else if (command == "state") {
+            valid = requirePosition(error) && describeState(output, error);
+        } else if (command == "save") {
+            valid = requirePosition(error) && save(output, error);
+        } else if (command == "quit") {
+            running = false;
+        } else {
+            error = "Unknown command \"" + command + "\"";
+            valid = false;
+        }
+    }
+
+    if (!valid) {
+        output.resize(mark);
+        JsonMessage::appendKey(output, "ok");
+        output += "false";
+        JsonMessage::appendKey(output, "error");
+        JsonMessage::appendString(output, error);
+    }
+
+    output += "}\n";
+
+    return running;
+}
+
+bool BotProtocol::setPosition(string& output, string& error) {
+    shared_ptr<GameModel> position = make_shared<GameModel>();
+    bool valid = true;
+
+    if (request.has("file")) {
+        string fileName = request.getString("file", "");
+
+        valid = ModelBuilder(*position).loadSaveFile(fileName);
+        if (!valid) {
+            error = "Could not load " + fileName;
+        }
+    } else if (request.has("azl")) {
+        string text = request.getString("azl", "");
+
+        valid = ModelBuilder(*position).loadSaveText(text.data(), text.size()) && position->validate();
+        if (!valid) {
+            error = "Save text is defective";
+        }
+    } else if (request.has("azb")) {
+        vector<uint8_t> data;
+
+        valid = readHex(request.getString("azb", ""), data) &&
+                CompactSave::decode(data.data(), data.size(), *position);
+        if (!valid) {
+            error = "Compact save is defective";
+        }
+    } else if (request.getBool("new", false)) {
+        long numberOfPlayers = request.getNumber("players", 2);
+        long numberOfCentres = request.getNumber("centres", 1);
+        string names = request.getString("names", "");
+        vector<string> playerNames;
+
+        for (long i = 0; i < numberOfPlayers && i < MAX_STATE_PLAYERS; ++i) {
+            playerNames.push_back("Player " + to_string(i + 1));
+        }
+
+        // Names given replace the defaults, in order
+        string::size_type start = 0;
+        for (unsigned int i = 0; i != playerNames.size() && start <= names.size() && !names.empty(); ++i) {
+            string::size_type end = names.find(',', start);
+
+            if (end == string::npos) {
+                end = names.size();
+            }
+
+            playerNames[i] = names.substr(start, end - start);
+            start = end + 1;
+        }
+
+        valid = numberOfPlayers >= 2 && numberOfPlayers <= MAX_STATE_PLAYERS &&
+                numberOfCentres >= 1 && numberOfCentres <= MAX_STATE_CENTRES &&
+                ModelBuilder(*position).createNewGame(numberOfCentres, playerNames.data(), numberOfPlayers,
+                                                      request.getNumber("seed", seed));
+        if (valid) {
+            GameRules(*position).startGame();
+        } else {
+            error = "A new game needs 2-4 players and 1-2 centres";
+        }
+    } else {
+        error = "Give a file, azl, azb or new";
+        valid = false;
+    }
+
+    if (valid) {
+        gameModel = position;
+        havePosition = true;
+
+        JsonMessage::appendKey(output, "player");
+        output += to_string(gameModel->getCurrentPlayerIndex());
+    }
+
+    return valid;
+}
+
+bool BotProtocol::listMoves(string& output, string& error) {
+    Move moves[MAX_MOVES];
+    unsigned int numberOfMoves = MoveGenerator(*gameModel).generate(moves);
+
+    JsonMessage::appendKey(output, "moves");
+    output += '[';
+    for (unsigned int i = 0; i != numberOfMoves; ++i) {
+        if (i != 0) {
+            output += ',';
+        }
+
+        JsonMessage::appendString(output, moves[i].toString(showsCentre(moves[i])));
+    }
+    output += ']';
+
+    JsonMessage::appendKey(output, "count");
+    output += to_string(numberOfMoves);
+
+    return true;
+}
+
+bool BotProtocol::playMove(string& output, string& error) {
+    bool dumpGiven = false;
+    string text = request.getString("move", "");
+    Move move = Move::parse(text, dumpGiven);
+    bool valid = move.isValid() && MoveGenerator(*gameModel).isLegal(move);
+
+    if (!valid) {
+        error = "Illegal move \"" + text + "\"";
+    } else if (!dumpGiven && showsCentre(move)) {
+        error = "Say which centre takes the leftover tiles, C or D";
+        valid = false;
+    } else {
+        GameRules rules(*gameModel);
+        MoveResult result = rules.applyMove(move);
+
+        if (!gameModel->isConserved()) {
+            error = "Game is defective";
+            valid = false;
+            havePosition = false;
+        } else {
+            JsonMessage::appendKey(output, "result");
+            JsonMessage::appendString(output, result == GAME_OVER ? "game" : result == ROUND_OVER ? "round" : "move");
+            JsonMessage::appendKey(output, "player");
+            output += to_string(gameModel->getCurrentPlayerIndex());
+
+            if (result == GAME_OVER) {
+                JsonMessage::appendKey(output, "winner");
+                output += to_string(rules.getWinner());
+            }
+        }
+    }
+
+    return valid;
+}
+
+bool BotProtocol::think(string& output, string& error) {
+    string name = request.getString("policy", POLICY_MCTS);
+    long depth = request.getNumber("depth", 0);
+    long playouts = request.getNumber("playouts", 0);
+
+    // A depth or playout budget replaces the time limit, unless one is given
+    long movetime = request.getNumber("movetime", depth > 0 || playouts > 0 ? 0 : PROTOCOL_DEFAULT_MOVETIME);
+    string settings = name + ":" + to_string(movetime) + ":" + to_string(depth) + ":" + to_string(playouts);
+    bool valid = movetime >= 0 && depth >= 0 && playouts >= 0;
+
+    if (valid && settings != policySettings) {
+        if (name == POLICY_MCTS) {
+            policy = make_shared<MctsPolicy>(seed, 0, playouts, movetime);
+        } else if (name == POLICY_ALPHABETA) {
+            int maxDepth = depth > 0 ? depth : movetime > 0 ? PROTOCOL_MAX_DEPTH : ALPHA_BETA_DEFAULT_DEPTH;
+            policy = make_shared<AlphaBetaPolicy>(seed, maxDepth, movetime);
+        } else {
+            policy = Policy::create(name, seed);
+        }
+
+        policySettings = policy ? settings : "";
+    }
+
+    Move moves[MAX_MOVES];
+    unsigned int numberOfMoves = MoveGenerator(*gameModel).generate(moves);
+
+    if (!valid) {
+        error = "Limits can't be negative";
+    } else if (!policy) {
+        error = "Unknown policy \"" + name + "\"";
+        valid = false;
+    } else if (numberOfMoves == 0) {
+        error = "No moves to choose from";
+        valid = false;
+    } else {
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        Move move = policy->chooseMove(*gameModel, moves, numberOfMoves);
+        std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        char number[32];
+
+        JsonMessage::appendKey(output, "move");
+        JsonMessage::appendString(output, move.toString(showsCentre(move)));
+
+        snprintf(number, sizeof(number), "%.3f", elapsed.count());
+        JsonMessage::appendKey(output, "ms");
+        output += number;
+
+        AlphaBetaPolicy* alphaBeta = dynamic_cast<AlphaBetaPolicy*>(policy.get());
+        MctsPolicy* mcts = dynamic_cast<MctsPolicy*>(policy.get());
+
+        if (alphaBeta != nullptr) {
+            JsonMessage::appendKey(output, "depth");
+            output += to_string(alphaBeta->getCompletedDepth());
+            JsonMessage::appendKey(output, "nodes");
+            output += to_string(alphaBeta->getNodes());
+        } else if (mcts != nullptr) {
+            JsonMessage::appendKey(output, "playouts");
+            output += to_string(mcts->getPlayouts());
+        }
+    }
+
+    return valid;
+}
+
+bool BotProtocol::describeState(string& output, string& error) {
+    char hash[24];
+
+    JsonMessage::appendKey(output, "player");
+    output += to_string(gameModel->getCurrentPlayerIndex());
+    JsonMessage::appendKey(output, "first");
+    output += gameModel->isFirst() ? "true" : "false";
+    JsonMessage::appendKey(output, "bag");
+    output += to_string(gameModel->getTileBag()->getNumberOfTiles());
+    JsonMessage::appendKey(output, "lid");
+    output += to_string(gameModel->getBoxLid()->getNumberOfTiles());
+
+    JsonMessage::appendKey(output, "factories");
+    output += '[';
+    for (unsigned int i = 0; i != gameModel->getNumberOfFactories(); ++i) {
+        if (i != 0) {
+            output += ',';
+        }
+        JsonMessage::appendString(output, gameModel->getFactory(i)->toString());
+    }
+    output += ']';
+
+    JsonMessage::appendKey(output, "centres");
+    output += '[';
+    for (int i = 0; i != gameModel->getNumberOfCentreFactories(); ++i) {
+        if (i != 0) {
+            output += ',';
+        }
+        JsonMessage::appendString(output, gameModel->getTableCentre(i)->toString());
+    }
+    output += ']';
+
+    JsonMessage::appendKey(output, "players");
+    output += '[';
+    for (int i = 0; i != gameModel->getNumberOfPlayers(); ++i) {
+        shared_ptr<Player> player = gameModel->getAllPlayers()[i];
+        shared_ptr<PlayerBoard> board = player->getBoard();
+
+        if (i != 0) {
+            output += ',';
+        }
+
+        output += '{';
+        JsonMessage::appendKey(output, "name");
+        JsonMessage::appendString(output, player->getName());
+        JsonMessage::appendKey(output, "score");
+        output += to_string(player->getScore());
+
+        // Rows as in a save, with "-" for each space
+        JsonMessage::appendKey(output, "lines");
+        output += '[';
+        for (int row = 0; row != 5; ++row) {
+            if (row != 0) {
+                output += ',';
+            }
+            JsonMessage::appendString(output, board->getPatternLine(row)->toString());
+        }
+        output += ']';
+
+        JsonMessage::appendKey(output, "wall");
+        output += '[';
+        for (int row = 0; row != 5; ++row) {
+            if (row != 0) {
+                output += ',';
+            }
+            JsonMessage::appendString(output, board->getMosaic().toString(row));
+        }
+        output += ']';
+
+        JsonMessage::appendKey(output, "floor");
+        JsonMessage::appendString(output, board->getFloorLine()->toString());
+        output += '}';
+    }
+    output += ']';
+
+    // Too large for a JSON number to hold exactly
+    snprintf(hash, sizeof(hash), "%016llx", (unsigned long long) gameModel->getHash());
+    JsonMessage::appendKey(output, "hash");
+    JsonMessage::appendString(output, hash);
+
+    return true;
+}
+
+bool BotProtocol::save(string& output, string& error) {
+    string format = request.getString("format", "azl");
+    bool valid = true;
+
+    if (format == "azl") {
+        saveWriter.write(*gameModel);
+
+        JsonMessage::appendKey(output, "azl");
+        JsonMessage::appendString(output, string(saveWriter.getData(), saveWriter.getSize()));
+    } else if (format == "azb") {
+        vector<uint8_t> data;
+
+        valid = CompactSave::encode(*gameModel, data);
+        if (valid) {
+            JsonMessage::appendKey(output, "azb");
+            appendHex(output, data.data(), data.size());
+        } else {
+            error = "The game does not fit a compact save";
+        }
+    } else {
+        error = "Unknown format \"" + format + "\"";
+        valid = false;
+    }
+
+    return valid;
+}
+
+bool BotProtocol::requirePosition(string& error) {
+    if (!havePosition) {
+        error = "No position has been set";
+    }
+
+    return havePosition;
+}
+
+bool BotProtocol::showsCentre(Move move) {
+    return move.getSource() < CENTRE_SLOT_OFFSET && gameModel->getNumberOfCentreFactories() == 2;
+}
+
+bool BotProtocol::readLine(string& line) {
+    bool found = false;
+    bool ended = false;
+    string::size_type end = input.find('\n', inputStart);
+
+    while (end == string::npos && !ended) {
+        // Drop what has been answered before reading more
+        input.erase(0, inputStart);
+        inputStart = 0;
+
+        size_t size = input.size();
+        input.resize(size + PROTOCOL_READ_SIZE);
+        ssize_t received = read(STDIN_FILENO, &input[size], PROTOCOL_READ_SIZE);
+
+        input.resize(size + (received > 0 ? received : 0));
+
+        if (received == 0 || (received < 0 && errno != EINTR)) {
+            ended = true;
+        } else {
+            end = input.find('\n', size);
+        }
+    }
+
+    if (end != string::npos) {
+        line.assign(input, inputStart, end - inputStart);
+        inputStart = end + 1;
+        found = true;
+    } else if (inputStart < input.size()) {
+        // A last request may come without a newline
+        line.assign(input, inputStart, string::npos);
+        inputStart = input.size();
+        found = true;
+    }
+
+    return found;
+}
+
+bool BotProtocol::writeAll(const string& output) {
+    bool valid = true;
+    size_t written = 0;
+
+    // One write unless the pipe is full
+    while (valid && written < output.size()) {
+        ssize_t sent = write(STDOUT_FILENO, output.data() + written, output.size() - written);
+
+        if (sent > 0) {
+            written += sent;
+        } else {
+            valid = sent < 0 && errno == EINTR;
+        }
+    }
+
+    return valid;
+}
+
+void BotProtocol::appendHex(string& output, const uint8_t* data, size_t size) {
+    static const char digits[] = "0123456789abcdef";
+
+    output += '"';
+    for (size_t i = 0; i != size; ++i) {
+        output += digits[data[i] >> 4];
+        output += digits[data[i] & 0xF];
+    }
+    output += '"';
+}
+
+bool BotProtocol::readHex(const string& text, vector<uint8_t>& data) {
+    bool valid = text.size() % 2 == 0;
+
+    for (size_t i = 0; i + 1 < text.size() && valid; i += 2) {
+        int value = 0;
+
+        for (size_t j = i; j != i + 2 && valid; ++j) {
+            char c = text[j];
+
+            if (c >= '0' && c <= '9') {
+                value = value * 16 + (c - '0');
+            } else if (c >= 'a' && c <= 'f') {
+                value = value * 16 + (c - 'a' + 10);
+            } else if (c >= 'A' && c <= 'F') {
+                value = value * 16 + (c - 'A' + 10);
+            } else {
+                valid = false;
+            }
+        }
+
+        data.push_back((uint8_t) value);
+    }
+
+    return valid;
+}
@@ -0,0 +1,111 @@
+/*
+ * Bot Protocol
+ *
+ * A machine interface to the engine over stdin and stdout, in the spirit
+ * of UCI for chess. Each request is a JSON object on one line, with a "cmd"
+ * and optionally an "id", which is echoed back. Each reply is a JSON object
+ * on one line, written in a single write, with "ok" and, when that is
+ * false, an "error".
+ *
+ *   hello                  protocol name and version
+ *   isready                answered as soon as the engine is ready
+ *   position               set the position from "file" (text or compact),
+ *                          "azl" (save text), "azb" (compact save in hex),
+ *                          or "new" with "players", "centres", "seed" and
+ *                          "names" (separated by commas)
+ *   moves                  legal moves for the current player
+ *   play                   play "move", e.g. "2 Y 5 C"
+ *   go                     choose a move without playing it, with "policy"
+ *                          (mcts, alphabeta, greedy or random), "movetime"
+ *                          in milliseconds, "depth" or "playouts"
+ *   state                  the whole position
+ *   save                   the position as "azl" text or "azb" hex, by
+ *                          "format"
+ *   quit                   stop
+ *
+ * Authors: C. Hodgen (s3031209), J. Osrecak (s3782455)
+ */
+
+#ifndef BOT_PROTOCOL_H
+#define BOT_PROTOCOL_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "GameModel.h"
+#include "JsonMessage.h"
+#include "Move.h"
+#include "Policy.h"
+#include "SaveWriter.h"
+
+#define PROTOCOL_NAME               "azul-json"
+#define PROTOCOL_VERSION            1
+
+// Bytes read from stdin at once
+#define PROTOCOL_READ_SIZE          65536
+
+// Time given to "go" when it sets no limit of its own
+#define PROTOCOL_DEFAULT_MOVETIME   1000
+
+// Deepest a timed alpha-beta search may go, well past any it reaches
+#define PROTOCOL_MAX_DEPTH          64
+
+class BotProtocol {
+    public:
+        BotProtocol();
+
+        // Seed for new games and the policies, instead of a random seed
+        void setSeed(int seed);
+
+        // Answer requests from stdin until it ends or "quit"
+        void run();
+
+        // Answer one request, replacing output with the reply line.
+        // Returns false once "quit" has been asked for.
+        bool handle(const std::string& line, std::string& output);
+
+    private:
+        std::shared_ptr<GameModel> gameModel;
+        bool havePosition;
+        unsigned int seed;
+
+        // Kept between requests, so their memory is reused
+        JsonMessage request;
+        SaveWriter saveWriter;
+
+        // Input read but not yet answered, from inputStart on
+        std::string input;
+        size_t inputStart;
+
+        // Policy from the last "go", reused while the settings are the same
+        std::shared_ptr<Policy> policy;
+        std::string policySettings;
+
+        // Each command adds its fields to output, or returns false with
+        // the reason in error
+        bool setPosition(std::string& output, std::string& error);
+        bool listMoves(std::string& output, std::string& error);
+        bool playMove(std::string& output, std::string& error);
+        bool think(std::string& output, std::string& error);
+        bool describeState(std::string& output, std::string& error);
+        bool save(std::string& output, std::string& error);
+
+        // True if there is a position, otherwise sets error
+        bool requirePosition(std::string& error);
+
+        // True if the move needs its dump centre shown to be read back
+        bool showsCentre(Move move);
+
+        // Read the next line from stdin. Returns false once it has ended.
+        bool readLine(std::string& line);
+
+        // Write all of a reply to stdout, returning false on failure
+        static bool writeAll(const std::string& output);
+
+        static void appendHex(std::string& output, const uint8_t* data, size_t size);
+        static bool readHex(const std::string& text, std::vector<uint8_t>& data);
+};
+
+#endif // BOT_PROTOCOL_H
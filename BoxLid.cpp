@@ -1,55 +1,67 @@
-
 #include "BoxLid.h"
 
-using std::make_shared;
 using std::make_unique;
 using std::map;
 using std::unique_ptr;
 
 BoxLid::BoxLid() :
-    tiles(LinkedList())
+    tiles(TileQueue())
 {}
 
 unsigned int BoxLid::getNumberOfTiles() {
     return tiles.size();
 }
 
-/* We're converting from unique to shared, so the underlying data structure
- * can freely copy items in its algorithms. That is to say, we are *trusting*
- * the linked list implementation to never make a duplicate tile and to never
- * lose a tile.
+unsigned int BoxLid::getNumberOfTiles(TileColour colour) {
+    return tiles.count(colour);
+}
+
+/* Only the colour is kept, the tile object itself is released here. The queue
+ * is trusted to never duplicate or lose a colour.
  */
 void BoxLid::add(std::unique_ptr<Tile> tile) {
-    tiles.addBack(make_shared<Tile>(Tile(*tile)));
+    tiles.push(tile->getColour());
+}
+
+void BoxLid::add(TileColour colour) {
+    tiles.push(colour);
 }
 
 /* Convert back to a unique pointer to signal to the calling class that it is
  * now the owner of, and responsible for, the object.
  */
 unique_ptr<Tile> BoxLid::remove() {
-    return make_unique<Tile>(*tiles.deleteFront());
+    return make_unique<Tile>(tiles.pop());
 }
 
-void BoxLid::reportTileCounts(std::map<TileColour, int>& tileCounts) {
+TileColour BoxLid::draw() {
+    return tiles.pop();
+}
 
-    for (unsigned int i = 0; i != tiles.size(); ++i) {
-        int newCount = 1;
-        auto count = tileCounts.find(tiles.get(i)->getColour());
-        
-        if (count != tileCounts.end()) {
-            newCount = count->second + 1;
-        } 
+TileColour BoxLid::removeLast() {
+    return tiles.popBack();
+}
 
-        tileCounts[tiles.get(i)->getColour()] = newCount;
-    }
+bool BoxLid::removeLast(TileColour colour) {
+    return tiles.removeLast(colour);
 }
 
-std::string BoxLid::toString() {
-    std::string result = "";
+TileColour BoxLid::getTile(unsigned int index) {
+    return tiles.get(index);
+}
+
+void BoxLid::clear() {
+    tiles.clear();
+}
+
+void BoxLid::shuffle(std::mt19937& engine) {
+    tiles.shuffle(engine);
+}
 
-    for (unsigned int i = 0; i != tiles.size(); ++i) {
-        result += tiles.get(i)->toString();
-    }
+void BoxLid::reportTileCounts(std::map<TileColour, int>& tileCounts) {
+    tiles.reportTileCounts(tileCounts);
+}
 
-    return result;
+std::string BoxLid::toString() {
+    return tiles.toString();
 }
@@ -1,4 +1,3 @@
-
 /*
  * Box lid
  * 
@@ -8,7 +7,13 @@
 #ifndef BOX_LID_H
 #define BOX_LID_H
 
-#include "LinkedList.h"
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+
+#include "Tile.h"
+#include "TileQueue.h"
 
 class BoxLid {
     public:
@@ -17,12 +22,37 @@ class BoxLid {
         // Return the number of tiles in the lid
         unsigned int getNumberOfTiles();
 
+        // Return the number of tiles of a colour in the lid
+        unsigned int getNumberOfTiles(TileColour colour);
+
         // Add a tile to the lid
         void add(std::unique_ptr<Tile> tile);
 
+        // Add a tile of the given colour to the lid
+        void add(TileColour colour);
+
         // Removes and returns a tile from the bag
         std::unique_ptr<Tile> remove();
 
+        // Removes a tile from the lid and returns its colour
+        TileColour draw();
+
+        // Removes the tile added most recently and returns its colour
+        TileColour removeLast();
+
+        // Removes the most recently added tile of a colour. Returns false if
+        // the lid has no tile of that colour.
+        bool removeLast(TileColour colour);
+
+        // Returns the colour of the tile at index, where 0 is drawn next
+        TileColour getTile(unsigned int index);
+
+        // Removes every tile from the lid
+        void clear();
+
+        // Put the tiles in the lid in a random order
+        void shuffle(std::mt19937& engine);
+
         // Provide a breakdown of the tiles in the lid
         void reportTileCounts(std::map<TileColour, int>& tileCounts);
 
@@ -30,7 +60,7 @@ class BoxLid {
         std::string toString();
         
     private:
-        LinkedList tiles;
+        TileQueue tiles;
 };
 
 #endif // BOX_LID_H
@@ -0,0 +1,343 @@
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "CompactSave.h"
+#include "MappedFile.h"
+#include "ModelBuilder.h"
+
+using std::shared_ptr;
+using std::string;
+using std::vector;
+
+CompactSave::BitWriter::BitWriter(vector<uint8_t>& data) :
+    data(data),
+    used(8)
+{}
+
+void CompactSave::BitWriter::write(unsigned int value, int bits) {
+    for (int i = 0; i != bits; ++i) {
+        if (used == 8) {
+            data.push_back(0);
+            used = 0;
+        }
+
+        data.back() |= ((value >> i) & 1u) << used;
+        ++used;
+    }
+}
+
+void CompactSave::BitWriter::writeVarint(unsigned int value) {
+    bool more = true;
+
+    while (more) {
+        more = value >= 0x80u;
+        write(value & 0x7Fu, 7);
+        write(more, 1);
+        value >>= 7;
+    }
+}
+
+CompactSave::BitReader::BitReader(const uint8_t* data, size_t size) :
+    data(data),
+    size(size),
+    position(0),
+    overrun(false)
+{}
+
+unsigned int CompactSave::BitReader::read(int bits) {
+    unsigned int value = 0;
+
+    for (int i = 0; i != bits; ++i) {
+        if (position / 8 < size) {
+            value |= ((data[position / 8] >> (position % 8)) & 1u) << i;
+        } else {
+            overrun = true;
+        }
+        ++position;
+    }
+
+    return value;
+}
+
+unsigned int CompactSave::BitReader::readVarint() {
+    unsigned int value = 0;
+    int shift = 0;
+    bool more = true;
+
+    // Scores never need more than 3 groups
+    while (more && shift != 21) {
+        value |= read(7) << shift;
+        more = read(1);
+        shift += 7;
+    }
+
+    if (more) {
+        overrun = true;
+    }
+
+    return value;
+}
+
+size_t CompactSave::BitReader::getByteOffset() {
+    return (position + 7) / 8;
+}
+
+bool CompactSave::BitReader::isOverrun() {
+    return overrun;
+}
+
+bool CompactSave::encode(GameModel& gameModel, vector<uint8_t>& data) {
+    bool encoded = true;
+    GameState state;
+    gameModel.saveState(state);
+
+    data.clear();
+    data.insert(data.end(), COMPACT_SAVE_MAGIC, COMPACT_SAVE_MAGIC + 3);
+    data.push_back(COMPACT_SAVE_VERSION);
+
+    BitWriter writer(data);
+
+    writer.write(state.numberOfPlayers - 2, 2);
+    writer.write(state.numberOfCentres - 1, 1);
+    writer.write(state.numberOfFactories, 4);
+    writer.write(state.currentPlayer, 2);
+    writer.write(state.firstOnTable, 1);
+
+    writeTiles(writer, state.bag);
+    writeTiles(writer, state.lid);
+
+    for (unsigned int i = 0; i != state.numberOfFactories; ++i) {
+        unsigned int size = 0;
+
+        for (int colour = 0; colour != NUMBER_OF_COLOURS; ++colour) {
+            size += state.getFactoryCount(i, (TileColour) colour);
+        }
+
+        if (size > 7) {
+            encoded = false;
+        }
+
+        writer.write(size, 3);
+        for (int colour = 0; colour != NUMBER_OF_COLOURS; ++colour) {
+            for (unsigned int n = 0; n != state.getFactoryCount(i, (TileColour) colour); ++n) {
+                writer.write(colour, 3);
+            }
+        }
+    }
+
+    for (unsigned int i = 0; i != state.numberOfCentres; ++i) {
+        unsigned int size = 0;
+
+        for (int colour = 0; colour != NUMBER_OF_COLOURS; ++colour) {
+            size += state.centres[i][colour];
+        }
+
+        writer.write(size, 7);
+        for (int colour = 0; colour != NUMBER_OF_COLOURS; ++colour) {
+            for (unsigned int n = 0; n != state.centres[i][colour]; ++n) {
+                writer.write(colour, 3);
+            }
+        }
+    }
+
+    for (unsigned int playerId = 0; playerId != state.numberOfPlayers; ++playerId) {
+        const PlayerState& player = state.players[playerId];
+
+        if (player.score < 0) {
+            encoded = false;
+        }
+
+        writer.write(player.wall, 25);
+        writer.writeVarint(player.score < 0 ? 0 : player.score);
+
+        for (int row = 0; row != 5; ++row) {
+            writer.write(player.lineCount[row], getLineCountBits(row));
+            if (player.lineCount[row] != 0) {
+                writer.write(player.lineColour[row], 3);
+            }
+        }
+
+        writer.write(player.floorCount, 3);
+        for (unsigned int i = 0; i != player.floorCount; ++i) {
+            writer.write(player.floor[i], 3);
+        }
+    }
+
+    // Names follow on whole bytes
+    for (shared_ptr<Player> player : gameModel.getAllPlayers()) {
+        const string& name = player->getName();
+
+        if (name.size() > 255) {
+            encoded = false;
+        } else {
+            data.push_back(name.size());
+            data.insert(data.end(), name.begin(), name.end());
+        }
+    }
+
+    return encoded;
+}
+
+bool CompactSave::decode(const uint8_t* data, size_t size, GameModel& gameModel) {
+    bool valid = isCompact(data, size);
+    GameState state;
+    vector<string> names;
+
+    std::memset(&state, 0, sizeof(GameState));
+
+    if (valid) {
+        BitReader reader(data + COMPACT_SAVE_HEADER, size - COMPACT_SAVE_HEADER);
+
+        state.numberOfPlayers = reader.read(2) + 2;
+        state.numberOfCentres = reader.read(1) + 1;
+        state.numberOfFactories = reader.read(4);
+        state.currentPlayer = reader.read(2);
+        state.firstOnTable = reader.read(1);
+
+        valid = state.numberOfPlayers <= MAX_STATE_PLAYERS &&
+                state.numberOfFactories <= MAX_STATE_FACTORIES &&
+                state.currentPlayer < state.numberOfPlayers &&
+                readTiles(reader, state.bag) &&
+                readTiles(reader, state.lid);
+
+        for (unsigned int i = 0; i != state.numberOfFactories && valid; ++i) {
+            unsigned int tiles = reader.read(3);
+
+            for (unsigned int n = 0; n != tiles && valid; ++n) {
+                TileColour colour = (TileColour) reader.read(3);
+
+                valid = colour < NUMBER_OF_COLOURS;
+                if (valid) {
+                    state.setFactoryCount(i, colour, state.getFactoryCount(i, colour) + 1);
+                }
+            }
+        }
+
+        for (unsigned int i = 0; i != state.numberOfCentres && valid; ++i) {
+            unsigned int tiles = reader.read(7);
+
+            for (unsigned int n = 0; n != tiles && valid; ++n) {
+                unsigned int colour = reader.read(3);
+
+                valid = colour < NUMBER_OF_COLOURS;
+                if (valid) {
+                    ++state.centres[i][colour];
+                }
+            }
+        }
+
+        for (unsigned int playerId = 0; playerId != state.numberOfPlayers && valid; ++playerId) {
+            PlayerState& player = state.players[playerId];
+            unsigned int score = 0;
+
+            player.wall = reader.read(25);
+            score = reader.readVarint();
+            player.score = score;
+            valid = score <= INT16_MAX;
+
+            for (int row = 0; row != 5 && valid; ++row) {
+                player.lineCount[row] = reader.read(getLineCountBits(row));
+                player.lineColour[row] = NONE;
+
+                if (player.lineCount[row] != 0) {
+                    player.lineColour[row] = reader.read(3);
+                    valid = player.lineColour[row] < NUMBER_OF_COLOURS;
+                }
+
+                valid = valid && player.lineCount[row] <= row + 1;
+            }
+
+            player.floorCount = reader.read(3);
+            for (unsigned int i = 0; i != player.floorCount && valid; ++i) {
+                player.floor[i] = reader.read(3);
+                valid = player.floor[i] <= FIRST;
+            }
+        }
+
+        valid = valid && !reader.isOverrun();
+
+        size_t offset = COMPACT_SAVE_HEADER + reader.getByteOffset();
+
+        for (unsigned int playerId = 0; playerId != state.numberOfPlayers && valid; ++playerId) {
+            valid = offset < size && offset + 1 + data[offset] <= size;
+
+            if (valid) {
+                names.push_back(string((const char*) data + offset + 1, data[offset]));
+                offset += 1 + data[offset];
+            }
+        }
+    }
+
+    if (valid) {
+        ModelBuilder(gameModel).loadState(state);
+
+        for (unsigned int playerId = 0; playerId != state.numberOfPlayers; ++playerId) {
+            gameModel.getAllPlayers()[playerId]->setName(names[playerId]);
+        }
+
+        valid = gameModel.validate();
+    }
+
+    return valid;
+}
+
+bool CompactSave::isCompact(const uint8_t* data, size_t size) {
+    return size >= COMPACT_SAVE_HEADER &&
+           std::memcmp(data, COMPACT_SAVE_MAGIC, 3) == 0 &&
+           data[3] == COMPACT_SAVE_VERSION;
+}
+
+bool CompactSave::save(GameModel& gameModel, const string& fileName) {
+    bool saved = false;
+    vector<uint8_t> data;
+
+    if (encode(gameModel, data)) {
+        std::ofstream outputFile(fileName, std::ios::binary);
+
+        outputFile.write((const char*) data.data(), data.size());
+        saved = outputFile.good();
+    }
+
+    return saved;
+}
+
+bool CompactSave::load(const string& fileName, GameModel& gameModel) {
+    MappedFile file(fileName);
+
+    return file.isOpen() && decode(file.getData(), file.getSize(), gameModel);
+}
+
+int CompactSave::getLineCountBits(int row) {
+    // Pattern line row holds up to row + 1 tiles
+    return 32 - __builtin_clz(row + 1);
+}
+
+void CompactSave::writeTiles(BitWriter& writer, const PackedTiles& tiles) {
+    writer.write(tiles.length, 7);
+
+    for (unsigned int i = 0; i != tiles.length; ++i) {
+        writer.write(tiles.get(i), 3);
+    }
+}
+
+bool CompactSave::readTiles(BitReader& reader, PackedTiles& tiles) {
+    bool valid = true;
+
+    tiles.length = reader.read(7);
+    valid = tiles.length <= TILE_QUEUE_CAPACITY;
+
+    for (unsigned int i = 0; i != tiles.length && valid; ++i) {
+        TileColour colour = (TileColour) reader.read(3);
+
+        valid = colour < NUMBER_OF_COLOURS;
+        if (valid) {
+            tiles.set(i, colour);
+        }
+    }
+
+    return valid;
+}
@@ -0,0 +1,108 @@
+/*
+ * Compact Save
+ * 
+ * A binary save format, packing a whole game into a few dozen bytes, for
+ * keeping very large numbers of positions. Files start with a 4 byte header,
+ * "AZB" and a version number, followed by a bit stream, least significant
+ * bit first:
+ * 
+ *   players - 2 (2 bits), centres - 1 (1), factories (4), current player (2),
+ *   first player marker on the table (1)
+ *   bag and lid: length (7), then each tile in order (3 each)
+ *   each factory: size (3), then its tiles by colour (3 each)
+ *   each centre: size (7), then its tiles by colour (3 each)
+ *   each player: wall (25), score as a varint (7 bits and a continue bit at
+ *   a time), each pattern line's tile count (1 to 3 bits, as it needs) and
+ *   its colour if not empty (3), floor line size (3) and tiles (3 each)
+ * 
+ * After the bit stream, from the next whole byte, comes each player's name as
+ * a length byte and the characters.
+ * 
+ * Files are read by mapping them into memory and decoding straight into a
+ * GameState, so there are no intermediate strings other than the names.
+ * 
+ * Authors: C. Hodgen (s3031209), J. Osrecak (s3782455)
+ */
+
+#ifndef COMPACT_SAVE_H
+#define COMPACT_SAVE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "GameModel.h"
+#include "GameState.h"
+
+#define COMPACT_SAVE_MAGIC      "AZB"
+#define COMPACT_SAVE_VERSION    1
+#define COMPACT_SAVE_HEADER     4
+
+// Usual extension for compact save files
+#define COMPACT_SAVE_EXTENSION  std::string(".azb")
+
+class CompactSave {
+    public:
+        // Pack a game. Returns false if the game will not fit the format,
+        // such as a name over 255 characters.
+        static bool encode(GameModel& gameModel, std::vector<uint8_t>& data);
+
+        // Unpack a game into a freshly made model. Returns false if the data
+        // is not a valid compact save, in which case the model is untouched,
+        // or if the game it holds fails GameModel::validate.
+        static bool decode(const uint8_t* data, size_t size, GameModel& gameModel);
+
+        // True if the data starts with the compact save header
+        static bool isCompact(const uint8_t* data, size_t size);
+
+        // Write a game to a file, returning false on failure
+        static bool save(GameModel& gameModel, const std::string& fileName);
+
+        // Read a game from a file, returning false if it cannot be opened or
+        // is not a valid compact save
+        static bool load(const std::string& fileName, GameModel& gameModel);
+
+    private:
+        // Appends values to a bit stream
+        class BitWriter {
+            public:
+                BitWriter(std::vector<uint8_t>& data);
+
+                void write(unsigned int value, int bits);
+                void writeVarint(unsigned int value);
+
+            private:
+                std::vector<uint8_t>& data;
+                int used;
+        };
+
+        // Reads values back from a bit stream. Reading past the end gives
+        // zeros and marks the stream as overrun.
+        class BitReader {
+            public:
+                BitReader(const uint8_t* data, size_t size);
+
+                unsigned int read(int bits);
+                unsigned int readVarint();
+
+                // Offset of the first whole byte not yet read
+                size_t getByteOffset();
+
+                bool isOverrun();
+
+            private:
+                const uint8_t* data;
+                size_t size;
+                size_t position;
+                bool overrun;
+        };
+
+        // Bits needed for a pattern line's tile count
+        static int getLineCountBits(int row);
+
+        static void writeTiles(BitWriter& writer, const PackedTiles& tiles);
+        static bool readTiles(BitReader& reader, PackedTiles& tiles);
+};
+
+#endif // COMPACT_SAVE_H
@@ -0,0 +1,495 @@
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "EndgameSolver.h"
+#include "ModelBuilder.h"
+#include "TranspositionTable.h"
+
+using std::shared_ptr;
+using std::string;
+using std::thread;
+using std::vector;
+
+EndgameSolver::EndgameSolver(unsigned int numberOfThreads) :
+    numberOfThreads(numberOfThreads),
+    cache(ENDGAME_CACHE_SHARDS),
+    orderMatters(false),
+    rootState(),
+    numberOfPlayers(0),
+    outcome(),
+    nodes(0)
+{
+    if (this->numberOfThreads == 0) {
+        this->numberOfThreads = thread::hardware_concurrency();
+    }
+    if (this->numberOfThreads == 0) {
+        this->numberOfThreads = 1;
+    }
+}
+
+bool EndgameSolver::isLastRound(GameModel& gameModel) {
+    bool lastRound = false;
+
+    for (shared_ptr<Player> player : gameModel.getAllPlayers()) {
+        shared_ptr<PlayerBoard> board = player->getBoard();
+
+        for (int row = 0; row != 5 && !lastRound; ++row) {
+            unsigned int line = (board->getMosaic().getWall() >> (row * 5)) & MOSAIC_ROW_MASK;
+
+            // A full pattern line always holds a colour missing from its row,
+            // so it completes a row that is one tile short
+            lastRound = __builtin_popcount(line) == 4 && board->getPatternLine(row)->isfull();
+        }
+    }
+
+    return lastRound;
+}
+
+bool EndgameSolver::isSolvable(GameModel& gameModel) {
+    return isLastRound(gameModel) ||
+           (gameModel.getTileBag()->getNumberOfTiles() == 0 && gameModel.getBoxLid()->getNumberOfTiles() == 0);
+}
+
+Move EndgameSolver::solve(GameModel& gameModel) {
+    gameModel.saveState(rootState);
+    numberOfPlayers = gameModel.getNumberOfPlayers();
+    orderMatters = !isLastRound(gameModel);
+
+    for (CacheShard& shard : cache) {
+        shard.entries.clear();
+    }
+
+    MoveGenerator moveGenerator(gameModel);
+    Move moves[MAX_MOVES];
+    unsigned int numberOfMoves = moveGenerator.generate(moves);
+
+    moveGenerator.order(moves, numberOfMoves, Move());
+    rootMoves.assign(moves, moves + numberOfMoves);
+    rootOutcomes.assign(numberOfMoves, Outcome());
+
+    // Threads take the next root move as they finish the last, and each
+    // root move is solved exactly, so every move can be compared
+    std::atomic<unsigned int> next(0);
+    std::atomic<unsigned long> visited(0);
+    vector<thread> workers;
+
+    for (unsigned int i = 0; i != numberOfThreads; ++i) {
+        workers.push_back(thread(&EndgameSolver::work, this, std::ref(next), std::ref(visited)));
+    }
+
+    for (thread& worker : workers) {
+        worker.join();
+    }
+
+    int player = gameModel.getCurrentPlayerIndex();
+    Move best = Move();
+
+    outcome = getScores(gameModel);
+    for (unsigned int i = 0; i != numberOfMoves; ++i) {
+        if (i == 0 || prefers(rootOutcomes[i], outcome, player)) {
+            outcome = rootOutcomes[i];
+            best = rootMoves[i];
+        }
+    }
+
+    principalVariation.clear();
+
+    if (best.isValid()) {
+        // Follow the best move on a copy, so the position is left as it is
+        GameModel model;
+        ModelBuilder(model).loadState(rootState);
+        GameRules rules(model);
+        MoveGenerator lineGenerator(model);
+        unsigned long count = 0;
+
+        principalVariation.push_back(best);
+        if (rules.applyMove(best) != GAME_OVER) {
+            playOut(model, rules, lineGenerator, count, &principalVariation);
+        }
+
+        visited += count;
+    }
+
+    nodes = visited.load();
+
+    return best;
+}
+
+const Outcome& EndgameSolver::getOutcome() {
+    return outcome;
+}
+
+const vector<Move>& EndgameSolver::getRootMoves() {
+    return rootMoves;
+}
+
+const vector<Outcome>& EndgameSolver::getRootOutcomes() {
+    return rootOutcomes;
+}
+
+const vector<Move>& EndgameSolver::getPrincipalVariation() {
+    return principalVariation;
+}
+
+unsigned long EndgameSolver::getNodes() {
+    return nodes;
+}
+
+void EndgameSolver::work(std::atomic<unsigned int>& next, std::atomic<unsigned long>& visited) {
+    // Each thread plays out moves on its own copy of the position
+    GameModel gameModel;
+    ModelBuilder(gameModel).loadState(rootState);
+    GameRules rules(gameModel);
+    MoveGenerator moveGenerator(gameModel);
+    unsigned long count = 0;
+    unsigned int index = next++;
+
+    while (index < rootMoves.size()) {
+        if (rules.applyMove(rootMoves[index]) == GAME_OVER) {
+            rootOutcomes[index] = getScores(gameModel);
+        } else {
+            rootOutcomes[index] = playOut(gameModel, rules, moveGenerator, count, nullptr);
+        }
+        rules.undoMove();
+
+        index = next++;
+    }
+
+    visited += count;
+}
+
+Outcome EndgameSolver::playOut(GameModel& gameModel, GameRules& rules, MoveGenerator& moveGenerator,
+                               unsigned long& visited, vector<Move>* line) {
+    unsigned int applied = 0;
+    bool playing = true;
+
+    while (playing) {
+        Move move = findBestMove(gameModel, rules, moveGenerator, visited);
+
+        if (move.isValid()) {
+            if (line != nullptr) {
+                line->push_back(move);
+            }
+
+            playing = rules.applyMove(move) != GAME_OVER;
+            ++applied;
+        } else {
+            playing = false;
+        }
+    }
+
+    Outcome result = getScores(gameModel);
+
+    for (unsigned int i = 0; i != applied; ++i) {
+        rules.undoMove();
+    }
+
+    return result;
+}
+
+Move EndgameSolver::findBestMove(GameModel& gameModel, GameRules& rules, MoveGenerator& moveGenerator,
+                                 unsigned long& visited) {
+    Move moves[MAX_MOVES];
+    unsigned int numberOfMoves = moveGenerator.generateDistinct(moves);
+    int player = gameModel.getCurrentPlayerIndex();
+    Move best = Move();
+
+    if (numberOfPlayers == 2) {
+        // Find the value exactly, then take the first move that reaches it,
+        // which only needs a search with the narrowest window around it
+        int target = search(gameModel, rules, moveGenerator, -ENDGAME_INFINITY, ENDGAME_INFINITY, visited);
+
+        for (unsigned int i = 0; i != numberOfMoves && !best.isValid(); ++i) {
+            int value = 0;
+
+            if (rules.applyMove(moves[i]) == GAME_OVER) {
+                value = getMargin(getScores(gameModel), player);
+            } else if (gameModel.getCurrentPlayerIndex() == player) {
+                value = search(gameModel, rules, moveGenerator, target - 1, target, visited);
+            } else {
+                value = -search(gameModel, rules, moveGenerator, -target, -target + 1, visited);
+            }
+            rules.undoMove();
+
+            if (value >= target) {
+                best = moves[i];
+            }
+        }
+    } else {
+        Outcome bestOutcome = Outcome();
+
+        for (unsigned int i = 0; i != numberOfMoves; ++i) {
+            Outcome child = rules.applyMove(moves[i]) == GAME_OVER ? getScores(gameModel)
+                                                                   : searchAll(gameModel, rules, moveGenerator, visited);
+            rules.undoMove();
+
+            if (i == 0 || prefers(child, bestOutcome, player)) {
+                bestOutcome = child;
+                best = moves[i];
+            }
+        }
+    }
+
+    return best;
+}
+
+int EndgameSolver::search(GameModel& gameModel, GameRules& rules, MoveGenerator& moveGenerator,
+                          int alpha, int beta, unsigned long& visited) {
+    int result = 0;
+    int player = gameModel.getCurrentPlayerIndex();
+    uint64_t key = getKey(gameModel);
+    CacheEntry entry;
+    Move tableMove;
+    bool cutoff = false;
+
+    ++visited;
+
+    if (probe(key, entry)) {
+        tableMove = entry.move;
+        result = entry.value;
+
+        cutoff = entry.bound == BOUND_EXACT ||
+                 (entry.bound == BOUND_LOWER && entry.value >= beta) ||
+                 (entry.bound == BOUND_UPPER && entry.value <= alpha);
+    }
+
+    if (!cutoff) {
+        Move moves[MAX_MOVES];
+        unsigned int numberOfMoves = moveGenerator.generateDistinct(moves);
+        int best = -ENDGAME_INFINITY;
+        int bestAlpha = alpha;
+
+        moveGenerator.order(moves, numberOfMoves, tableMove);
+
+        // With no tiles left to take the game cannot go on, so it ends with
+        // the scores as they are
+        if (numberOfMoves == 0) {
+            best = getMargin(getScores(gameModel), player);
+        }
+
+        entry.move = Move();
+
+        for (unsigned int i = 0; i != numberOfMoves && bestAlpha < beta; ++i) {
+            int value = 0;
+
+            if (rules.applyMove(moves[i]) == GAME_OVER) {
+                value = getMargin(getScores(gameModel), player);
+            } else if (gameModel.getCurrentPlayerIndex() == player) {
+                // Taking the first player marker can mean moving first again
+                value = search(gameModel, rules, moveGenerator, bestAlpha, beta, visited);
+            } else {
+                value = -search(gameModel, rules, moveGenerator, -beta, -bestAlpha, visited);
+            }
+            rules.undoMove();
+
+            if (value > best) {
+                best = value;
+                entry.move = moves[i];
+            }
+            if (best > bestAlpha) {
+                bestAlpha = best;
+            }
+        }
+
+        entry.value = best;
+        if (best <= alpha) {
+            entry.bound = BOUND_UPPER;
+        } else if (best >= beta) {
+            entry.bound = BOUND_LOWER;
+        } else {
+            entry.bound = BOUND_EXACT;
+        }
+        store(key, entry);
+
+        result = best;
+    }
+
+    return result;
+}
+
+Outcome EndgameSolver::searchAll(GameModel& gameModel, GameRules& rules, MoveGenerator& moveGenerator,
+                                 unsigned long& visited) {
+    uint64_t key = getKey(gameModel);
+    CacheEntry entry;
+
+    ++visited;
+
+    if (!probe(key, entry)) {
+        Move moves[MAX_MOVES];
+        unsigned int numberOfMoves = moveGenerator.generateDistinct(moves);
+        int player = gameModel.getCurrentPlayerIndex();
+
+        // With no tiles left to take the game cannot go on, so it ends with
+        // the scores as they are
+        entry.outcome = getScores(gameModel);
+        entry.value = 0;
+        entry.bound = BOUND_EXACT;
+        entry.move = Move();
+
+        for (unsigned int i = 0; i != numberOfMoves; ++i) {
+            Outcome child;
+
+            if (rules.applyMove(moves[i]) == GAME_OVER) {
+                child = getScores(gameModel);
+            } else {
+                child = searchAll(gameModel, rules, moveGenerator, visited);
+            }
+            rules.undoMove();
+
+            if (i == 0 || prefers(child, entry.outcome, player)) {
+                entry.outcome = child;
+                entry.move = moves[i];
+            }
+        }
+
+        store(key, entry);
+    }
+
+    return entry.outcome;
+}
+
+Outcome EndgameSolver::getScores(GameModel& gameModel) {
+    Outcome scores = Outcome();
+
+    for (int i = 0; i != numberOfPlayers; ++i) {
+        scores.scores[i] = gameModel.getAllPlayers()[i]->getScore();
+    }
+
+    return scores;
+}
+
+int EndgameSolver::getMargin(const Outcome& outcome, int playerIndex) {
+    int bestOther = 0;
+    bool first = true;
+
+    for (int i = 0; i != numberOfPlayers; ++i) {
+        if (i != playerIndex && (first || outcome.scores[i] > bestOther)) {
+            bestOther = outcome.scores[i];
+            first = false;
+        }
+    }
+
+    return outcome.scores[playerIndex] - bestOther;
+}
+
+bool EndgameSolver::prefers(const Outcome& candidate, const Outcome& best, int playerIndex) {
+    int candidateMargin = getMargin(candidate, playerIndex);
+    int bestMargin = getMargin(best, playerIndex);
+
+    // Between equal leads, take the higher score
+    return candidateMargin > bestMargin ||
+           (candidateMargin == bestMargin && candidate.scores[playerIndex] > best.scores[playerIndex]);
+}
+
+uint64_t EndgameSolver::getKey(GameModel& gameModel) {
+    uint64_t key = gameModel.getCanonicalHash();
+
+    if (orderMatters) {
+        // The position key only counts the tiles in the bag and lid, so mix
+        // in the order they will be drawn in
+        shared_ptr<TileBag> bag = gameModel.getTileBag();
+        shared_ptr<BoxLid> lid = gameModel.getBoxLid();
+        uint64_t order = 0xCBF29CE484222325ull;
+
+        for (unsigned int i = 0; i != bag->getNumberOfTiles(); ++i) {
+            order = (order ^ bag->getTile(i)) * 0x100000001B3ull;
+        }
+
+        order = (order ^ NONE) * 0x100000001B3ull;
+
+        for (unsigned int i = 0; i != lid->getNumberOfTiles(); ++i) {
+            order = (order ^ lid->getTile(i)) * 0x100000001B3ull;
+        }
+
+        key ^= order;
+    }
+
+    return key;
+}
+
+bool EndgameSolver::probe(uint64_t key, CacheEntry& entry) {
+    CacheShard& shard = cache[key % ENDGAME_CACHE_SHARDS];
+    std::lock_guard<std::mutex> guard(shard.lock);
+    bool found = false;
+
+    std::unordered_map<uint64_t, CacheEntry>::iterator item = shard.entries.find(key);
+    if (item != shard.entries.end()) {
+        entry = item->second;
+        found = true;
+    }
+
+    return found;
+}
+
+void EndgameSolver::store(uint64_t key, const CacheEntry& entry) {
+    CacheShard& shard = cache[key % ENDGAME_CACHE_SHARDS];
+    std::lock_guard<std::mutex> guard(shard.lock);
+    CacheEntry& stored = shard.entries[key];
+
+    // A new entry starts with no move, so is always replaced
+    if (!stored.move.isValid() || stored.bound != BOUND_EXACT) {
+        stored = entry;
+    }
+}
+
+string EndgameSolver::run(GameModel& gameModel) {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    Move best = solve(gameModel);
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    double seconds = elapsed.count();
+
+    vector<shared_ptr<Player>>& players = gameModel.getAllPlayers();
+    bool showCentre = gameModel.getNumberOfCentreFactories() == 2;
+    char line[160];
+    string result = "";
+
+    snprintf(line, sizeof(line), "Time:           %.3fs on %u threads, %lu positions, %.0f positions/sec\n",
+             seconds, numberOfThreads, nodes, seconds > 0 ? nodes / seconds : 0.0);
+    result += line;
+
+    if (best.isValid()) {
+        result += "Best move:      " + gameModel.getCurrentPlayer()->getName() + " plays " +
+                  best.toString(showCentre && best.getSource() < CENTRE_SLOT_OFFSET) + "\n";
+    } else {
+        result += "Best move:      none\n";
+    }
+
+    result += "Final scores:  ";
+    for (int i = 0; i != numberOfPlayers; ++i) {
+        result += " " + players[i]->getName() + " " + std::to_string(outcome.scores[i]);
+        result += i + 1 == numberOfPlayers ? "\n" : ",";
+    }
+
+    result += "Best line:     ";
+    for (Move move : getPrincipalVariation()) {
+        result += " " + move.toString(showCentre && move.getSource() < CENTRE_SLOT_OFFSET) + ",";
+    }
+    if (result.back() == ',') {
+        result.pop_back();
+    }
+    result += "\n\nMove         ";
+    for (int player = 0; player != numberOfPlayers; ++player) {
+        snprintf(line, sizeof(line), " %8.8s", players[player]->getName().c_str());
+        result += line;
+    }
+    result += "\n";
+
+    for (unsigned int i = 0; i != rootMoves.size(); ++i) {
+        snprintf(line, sizeof(line), "%-13s",
+                 rootMoves[i].toString(showCentre && rootMoves[i].getSource() < CENTRE_SLOT_OFFSET).c_str());
+        result += line;
+
+        for (int player = 0; player != numberOfPlayers; ++player) {
+            snprintf(line, sizeof(line), " %8d", rootOutcomes[i].scores[player]);
+            result += line;
+        }
+        result += "\n";
+    }
+
+    return result;
+}
@@ -0,0 +1,153 @@
+/*
+ * Endgame Solver
+ * 
+ * Finds the final scores under perfect play, once nothing hidden is left to
+ * decide the rest of the game: either the game is sure to end with the
+ * current round, or the bag and lid are both empty so no tile can be drawn
+ * that is not already on the table. Every line of play is followed to the
+ * final scoring, bonuses included.
+ * 
+ * Each player plays to maximise their lead over the best of the others.
+ * With 2 players this is an exact alpha-beta search on the difference in
+ * score; with more, every line is followed. Results are cached by position,
+ * with the factories taken in any order, in a table split into shards with a
+ * lock each. The moves at the root are shared out between threads that all
+ * use the one cache.
+ * 
+ * Authors: C. Hodgen (s3031209), J. Osrecak (s3782455)
+ */
+
+#ifndef ENDGAME_SOLVER_H
+#define ENDGAME_SOLVER_H
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "GameModel.h"
+#include "GameRules.h"
+#include "GameState.h"
+#include "Move.h"
+#include "MoveGenerator.h"
+
+// Number of separately locked parts of the cache
+#define ENDGAME_CACHE_SHARDS    64
+
+// Larger than any lead
+#define ENDGAME_INFINITY        30000
+
+// Final scores of every player
+struct Outcome {
+    int scores[MAX_STATE_PLAYERS];
+};
+
+class EndgameSolver {
+    public:
+        // Uses the given number of threads, or one per core for 0
+        EndgameSolver(unsigned int numberOfThreads);
+
+        // True if the game is sure to end once the current round is scored
+        static bool isLastRound(GameModel& gameModel);
+
+        // True if the rest of the game does not depend on tiles yet to be
+        // drawn, so that it can be solved
+        static bool isSolvable(GameModel& gameModel);
+
+        // Solve the game from the given position, which is left unchanged,
+        // and return the best move for the current player. Returns an
+        // invalid move if there are no moves to make.
+        Move solve(GameModel& gameModel);
+
+        // Final scores of the last position solved
+        const Outcome& getOutcome();
+
+        // Each move at the root of the last solve, with its final scores
+        const std::vector<Move>& getRootMoves();
+        const std::vector<Outcome>& getRootOutcomes();
+
+        // Best moves from the root of the last solve to the end of the game
+        const std::vector<Move>& getPrincipalVariation();
+
+        // Positions visited by the last solve
+        unsigned long getNodes();
+
+        // Solve the position, timing it, and return a printable report
+        std::string run(GameModel& gameModel);
+
+    private:
+        // What is known about one position. With 2 players, value is the
+        // lead of the player to move, and may only be a bound on it; with
+        // more, outcome holds the final scores.
+        struct CacheEntry {
+            Outcome outcome;
+            int value;
+            int bound;
+            Move move;
+        };
+
+        struct CacheShard {
+            std::mutex lock;
+            std::unordered_map<uint64_t, CacheEntry> entries;
+        };
+
+        unsigned int numberOfThreads;
+        std::vector<CacheShard> cache;
+
+        // True when positions with the same tiles drawn in a different order
+        // can play out differently, so the order is part of the key
+        bool orderMatters;
+
+        GameState rootState;
+        int numberOfPlayers;
+        Outcome outcome;
+        std::vector<Move> rootMoves;
+        std::vector<Outcome> rootOutcomes;
+        std::vector<Move> principalVariation;
+        unsigned long nodes;
+
+        // Take root moves until there are none left, then add to the count
+        // of positions visited
+        void work(std::atomic<unsigned int>& next, std::atomic<unsigned long>& visited);
+
+        // Final scores under perfect play, following the best moves from the
+        // position to the end of the game. The position is left unchanged.
+        Outcome playOut(GameModel& gameModel, GameRules& rules, MoveGenerator& moveGenerator,
+                        unsigned long& visited, std::vector<Move>* line);
+
+        // Best move from the position. Cached moves are not used, as a
+        // position cached under the same key may have its factories in a
+        // different order.
+        Move findBestMove(GameModel& gameModel, GameRules& rules, MoveGenerator& moveGenerator,
+                          unsigned long& visited);
+
+        // Lead of the player to move under perfect play, for 2 players,
+        // searched within the window alpha to beta
+        int search(GameModel& gameModel, GameRules& rules, MoveGenerator& moveGenerator,
+                   int alpha, int beta, unsigned long& visited);
+
+        // Final scores under perfect play, for more than 2 players
+        Outcome searchAll(GameModel& gameModel, GameRules& rules, MoveGenerator& moveGenerator,
+                          unsigned long& visited);
+
+        // Scores as they stand, for a finished game
+        Outcome getScores(GameModel& gameModel);
+
+        // Lead of a player over the best of the others
+        int getMargin(const Outcome& outcome, int playerIndex);
+
+        // True if player would rather have candidate than best
+        bool prefers(const Outcome& candidate, const Outcome& best, int playerIndex);
+
+        // Cache key of a position
+        uint64_t getKey(GameModel& gameModel);
+
+        bool probe(uint64_t key, CacheEntry& entry);
+
+        // Exact results are never replaced, as they hold for any window
+        void store(uint64_t key, const CacheEntry& entry);
+};
+
+#endif // ENDGAME_SOLVER_H
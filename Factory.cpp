@@ -1,77 +1,139 @@
-
 #include <map>
 #include <memory>
-#include <vector>
+#include <string>
 
 #include "Factory.h"
 #include "Tile.h"
 
 using std::map;
-using std::move;
 using std::string;
 using std::unique_ptr;
-using std::vector;
 
 Factory::Factory() :
-    tiles(vector<unique_ptr<Tile>>())
-{}
+    total(0)
+{
+    clear();
+}
 
 void Factory::add(unique_ptr<Tile> tile) {
-    tiles.push_back(move(tile));
+    add(tile->getColour(), 1);
+}
+
+void Factory::add(TileColour colour) {
+    add(colour, 1);
+}
+
+void Factory::add(TileColour colour, unsigned int count) {
+    if (colour < NUMBER_OF_COLOURS) {
+        counts[colour] += count;
+        total += count;
+    }
 }
 
 bool Factory::contains(TileColour colour) {
-    bool result = false;
-    
-    for (const unique_ptr<Tile>& tile : tiles) {
-        if (tile->getColour() == colour) {
-            result = true;
-        }
+    return count(colour) != 0;
+}
+
+unsigned int Factory::count(TileColour colour) {
+    unsigned int result = 0;
+
+    if (colour < NUMBER_OF_COLOURS) {
+        result = counts[colour];
     }
 
     return result;
 }
 
-vector<unique_ptr<Tile>> Factory::getTiles() {
-    vector<unique_ptr<Tile>> result = move(tiles);
-    tiles = vector<unique_ptr<Tile>>();
-    return result;
+unsigned int Factory::size() {
+    return total;
 }
 
-void Factory::reportTileCounts(std::map<TileColour, int>& tileCounts) {
+unsigned int Factory::getColourMask() {
+    unsigned int mask = 0;
+
+    for (unsigned int i = 0; i != NUMBER_OF_COLOURS; ++i) {
+        if (counts[i] != 0) {
+            mask |= 1u << i;
+        }
+    }
+
+    return mask;
+}
 
-    for (unsigned int i = 0; i < tiles.size(); ++i) {
-        int newCount = 1;
-        auto count = tileCounts.find(tiles.at(i)->getColour());
-        
-        if (count != tileCounts.end()) {
-            newCount = count->second + 1;
-        } 
+unsigned int Factory::take(TileColour colour) {
+    unsigned int taken = count(colour);
 
-        tileCounts[tiles.at(i)->getColour()] = newCount;
+    if (taken != 0) {
+        counts[colour] = 0;
+        total -= taken;
     }
+
+    return taken;
 }
 
-bool Factory::isEmpty() {
-    return tiles.size() == 0 ? true : false;
+unsigned int Factory::take(TileColour colour, Factory& centre) {
+    unsigned int taken = take(colour);
+
+    // Whatever is left over is moved to the centre
+    for (unsigned int i = 0; i != NUMBER_OF_COLOURS; ++i) {
+        centre.counts[i] += counts[i];
+    }
+    centre.total += total;
+
+    clear();
+
+    return taken;
 }
 
-string Factory::toString() {
-    std::string result = "";
+unsigned int Factory::remove(TileColour colour, unsigned int number) {
+    unsigned int removed = count(colour);
 
-    for (unsigned int i = 0; i != tiles.size(); ++i) {
-        result += tiles.at(i)->toString();
+    if (removed > number) {
+        removed = number;
     }
 
-    return result;
+    if (removed != 0) {
+        counts[colour] -= removed;
+        total -= removed;
+    }
+
+    return removed;
 }
 
-string Factory::getPrintable() {
+void Factory::clear() {
+    for (unsigned int i = 0; i != NUMBER_OF_COLOURS; ++i) {
+        counts[i] = 0;
+    }
+
+    total = 0;
+}
+
+void Factory::reportTileCounts(std::map<TileColour, int>& tileCounts) {
+    for (unsigned int i = 0; i != NUMBER_OF_COLOURS; ++i) {
+        if (counts[i] != 0) {
+            tileCounts[(TileColour) i] += counts[i];
+        }
+    }
+}
+
+bool Factory::isEmpty() {
+    return total == 0;
+}
+
+string Factory::toString() {
     std::string result = "";
 
-    for (unsigned int i = 0; i != tiles.size(); ++i) {
-        result += tiles.at(i)->colouredToString();
+    for (unsigned int i = 0; i != NUMBER_OF_COLOURS; ++i) {
+        for (unsigned int j = 0; j != counts[i]; ++j) {
+            result += Tile::toString((TileColour) i);
+        }
     }
 
     return result;
 }
+
+void Factory::print(OutputFrame& frame) {
+    for (unsigned int i = 0; i != NUMBER_OF_COLOURS; ++i) {
+        frame.addTiles((TileColour) i, counts[i]);
+    }
+}
@@ -1,17 +1,23 @@
-
 /*
  * Factory
  * 
+ * Holds a count of each colour of tile, rather than the tiles themselves.
+ * The order of tiles in a factory has no meaning in the rules, so the counts
+ * are all that is needed. Also used for the table centre.
+ * 
  * Authors: C. Hodgen (s3031209), J. Osrecak (s3782455)
  */
 
 #ifndef FACTORY_H
 #define FACTORY_H
 
+#include <map>
 #include <memory>
-#include <vector>
+#include <string>
 
+#include "OutputFrame.h"
 #include "Tile.h"
+#include "TileQueue.h"
 
 class Factory {
     public:
@@ -19,11 +25,36 @@ class Factory {
 
         void add(std::unique_ptr<Tile> tile);
 
+        // Add a tile of the given colour
+        void add(TileColour colour);
+
+        // Add a number of tiles of the given colour
+        void add(TileColour colour, unsigned int count);
+
         // Checks if the factory contains a colour
         bool contains(TileColour colour);
 
-        // Return a list of all the tiles
-        std::vector<std::unique_ptr<Tile>> getTiles();
+        // Return the number of tiles of a colour in the factory
+        unsigned int count(TileColour colour);
+
+        // Return the total number of tiles in the factory
+        unsigned int size();
+
+        // Mask of the colours present, bit n for colour n
+        unsigned int getColourMask();
+
+        // Remove all tiles of a colour, and return how many were removed
+        unsigned int take(TileColour colour);
+
+        // Remove all tiles of a colour, moving every other tile to the centre.
+        // Returns how many tiles of the colour were removed.
+        unsigned int take(TileColour colour, Factory& centre);
+
+        // Remove up to count tiles of a colour, and return how many were removed
+        unsigned int remove(TileColour colour, unsigned int count);
+
+        // Remove all tiles
+        void clear();
 
         // Provide a breakdown of the tiles in the factory
         void reportTileCounts(std::map<TileColour, int>& tileCounts);
@@ -33,10 +64,16 @@ class Factory {
 
         // Get a printable version of the tiles in the factory.
         std::string toString();
-        
-        std::string getPrintable();
+
+        // Add the tiles in the factory to a screen
+        void print(OutputFrame& frame);
+
     protected:
-        std::vector<std::unique_ptr<Tile>> tiles;
+        // Number of tiles of each colour
+        unsigned char counts[NUMBER_OF_COLOURS];
+
+        // Total number of tiles, across all colours
+        unsigned char total;
 };
 
 #endif // FACTORY_H
@@ -15,8 +15,8 @@ string FloorLine::toString() {
     string result = "";
 
     for (unsigned int i = 0; i != LINE_SIZE; ++i) {
-        if (i < tiles.size()) {
-            result += tiles[i]->toString();
+        if (i < count) {
+            result += Tile::toString((TileColour) tiles[i]);
         } else {
             result += Tile::toString(NONE);
         }
@@ -25,17 +25,13 @@ string FloorLine::toString() {
     return result;
 }
 
-string FloorLine::getPrintable()
+void FloorLine::print(OutputFrame& frame)
 {
-    string result = "";
-
     for (unsigned int i = 0; i != LINE_SIZE; ++i) {
-        if (i < tiles.size()) {
-            result += tiles[i]->colouredToString();
+        if (i < count) {
+            frame.addTile((TileColour) tiles[i]);
         } else {
-            result += Tile::colouredToString(NONE);
+            frame.addTile(NONE);
         }
     }
-
-    return result;
 }
@@ -10,6 +10,7 @@
 #ifndef FLOOR_LINE_H
 #define FLOOR_LINE_H
 
+#include "OutputFrame.h"
 #include "PatternLine.h"
 
 class FloorLine : public PatternLine {
@@ -19,7 +20,8 @@ class FloorLine : public PatternLine {
         // Get a printable string of the tile colours
         std::string toString();
 
-        std::string getPrintable();
+        // Add the floor line to a screen, with "-" for each space
+        void print(OutputFrame& frame);
 };
 
 #endif // FLOOR_LINE_H
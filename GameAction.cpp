@@ -1,8 +1,6 @@
 
 #include "GameAction.h"
 
-using std::shared_ptr;
-
 GameAction::GameAction() :
     type_(UNKNOWN)
 {}
@@ -11,9 +9,9 @@ GameAction::GameAction(ActionType type) :
     type_(type)
 {}
 
-GameAction::GameAction(ActionType type, shared_ptr<GameTurn> turn) :
+GameAction::GameAction(ActionType type, Move move) :
     type_(type),
-    turn(turn)
+    move(move)
 {}
 
 GameAction::GameAction(ActionType type, int playerIndex)
@@ -26,8 +24,8 @@ ActionType GameAction::type() {
     return type_;
 }
 
-shared_ptr<GameTurn> GameAction::getTurn() {
-    return turn;
+Move GameAction::getMove() {
+    return move;
 }
 
 int GameAction::getPlayerIndex()
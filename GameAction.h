@@ -11,7 +11,7 @@
 #include <memory>
 #include <string>
 
-#include "GameTurn.h"
+#include "Move.h"
 
 enum ActionType {
     TURN,
@@ -30,21 +30,21 @@ class GameAction {
     public:
         GameAction();
         GameAction(ActionType type);
-        GameAction(ActionType type, std::shared_ptr<GameTurn> turn);
+        GameAction(ActionType type, Move move);
         GameAction(ActionType, int playerIndex);
 
         // Returns the type of action
         ActionType type();
 
-        // Return the turn requested
-        std::shared_ptr<GameTurn> getTurn();
+        // Return the move requested
+        Move getMove();
 
         //Returns players name
         int getPlayerIndex();
 
     private:
         ActionType type_;
-        std::shared_ptr<GameTurn> turn;
+        Move move;
         int playerIndex;
 };
 
@@ -1,21 +1,22 @@
 
-#include <map>
 #include <memory>
+#include <stdexcept>
 #include <string>
 #include <utility>
 
 #include "GameAction.h"
 #include "GameEngine.h"
-#include "GameTurn.h"
+#include "GameRules.h"
 #include "IOHandler.h"
 #include "Menu.h"
 #include "ModelBuilder.h"
+#include "MoveGenerator.h"
+#include "Policy.h"
 #include "Types.h"
 
 #include <random>
 
 using std::make_shared;
-using std::map;
 using std::numeric_limits;
 using std::shared_ptr;
 using std::string;
@@ -27,6 +28,7 @@ GameEngine::GameEngine() :
     gameModel(make_shared<GameModel>()),
     ioHandler(make_shared<IOHandler>()),
     menu(make_shared<Menu>()),
+    frame(ioHandler->isTerminal()),
     seed(numeric_limits<int>::min()),
     inProgress(false),
     inMenu(false)
@@ -38,23 +40,33 @@ void GameEngine::setSeed(int seed) {
     this->seed = seed;
 }
 
+void GameEngine::setJournal(const std::string& fileName) {
+    journalFile = fileName;
+}
+
 void GameEngine::run() {
     bool exit = false;
 
     while (!exit) {
-        if (inProgress) {
+        if (inProgress && bots[gameModel->getCurrentPlayerIndex()]) {
+            // Bots take their turn without a prompt
             printPreTurnInfo();
+            playBotTurn();
         } else {
-            printMenu();
-        }
+            if (inProgress) {
+                printPreTurnInfo();
+            } else {
+                printMenu();
+            }
 
-        GameAction action = promptForAction();
+            GameAction action = promptForAction();
 
-        // Do the thing the player wants
-        performGameAction(action);
+            // Do the thing the player wants
+            performGameAction(action);
 
-        if (action.type() == EXIT) {
-            exit = true;
+            if (action.type() == EXIT) {
+                exit = true;
+            }
         }
     }
 }
@@ -74,33 +86,9 @@ void GameEngine::printMenu() {
 }
 
 void GameEngine::printPreTurnInfo() {
-    // Print the centre table
-    ioHandler->printToStdOut("\nTable Centre\nC: " + gameModel->getTableCentre(0)->getPrintable() + "\n");
-
-    if(gameModel->getNumberOfCentreFactories() == 2)
-    {
-        ioHandler->printToStdOut("D: " + gameModel->getTableCentre(1)->getPrintable() + "\n");
-    }
-
-    if(gameModel->isFirst())
-    {
-        ioHandler->printToStdOut( Tile::colouredToString(FIRST) + "\n\n");
-    }
-    else
-    {
-        ioHandler->printToStdOut("\n");
-    }
-    
-    // Print the factories
-    ioHandler->printToStdOut("Factories\n");
-    for (unsigned int i = 0; i != gameModel->getNumberOfFactories(); ++i) {
-        ioHandler->printToStdOut(to_string(i + 1) + ": " + gameModel->getFactory(i)->getPrintable() + "\n");
-    }
-
-    // Print the current player
-    ioHandler->printToStdOut("\nCurrent Player\n");
-    ioHandler->printToStdOut(gameModel->getCurrentPlayer()->getPrintable() + "\n\n");
-    
+    // The centre table, the factories and the current player
+    gameModel->print(frame);
+    ioHandler->printToStdOut(frame);
 }
 
 GameAction GameEngine::promptForAction() {
@@ -183,87 +171,42 @@ GameAction GameEngine::parseInput(const std::string input) {
 
 GameAction GameEngine::createGameTurn(string input) {
     GameAction action = UNKNOWN;
+    bool dumpGiven = false;
+    Move move = Move::parse(input, dumpGiven);
+
+    // All validation tests pass, so create the game turn
+    if (move.isValid() && MoveGenerator(*gameModel).isLegal(move)) {
+        // Leftovers from a centre are never dumped, and with only 1 centre
+        // there is no need to ask which centre to place into
+        if (!dumpGiven && move.getSource() < CENTRE_SLOT_OFFSET &&
+            gameModel->getNumberOfCentreFactories() == 2) {
+            move = Move(move.getSource(), move.getColour(), move.getDestination(), promptForDumpCentre());
+        }
 
-    /* valid formats: "{1} {2} {3}"
-    *   {1} = {'c', 'C', 'd', 'D', 1, 2, 3, 4, 5, 6, 7, 8, 9}
-    *   {2} = {'R', 'Y', 'B', 'L', 'U'}
-    *   {3} = {'F', 1, 2, 3, 4, 5}
-    */
-
-    try {
-        char sourceKey = input.at(0);
-        char colourKey = input.at(2);
-        char destKey = input.at(4);
-
-        int sourceIndex = getTurnSource(sourceKey);
-        int destinationIndex = getTurnDestination(destKey);
-        TileColour colour = getTurnColour(colourKey);
-
-        if (sourceIndex != -1 && destinationIndex != -1 && colour != NONE) {
-            shared_ptr<Factory> source = nullptr;
-            shared_ptr<PatternLine> destination = nullptr;
-
-            bool sourceCentre = false;
-            // Get pointer to the requested destination, but only if its a valid move
-            if (destinationIndex < 5) {
-                // any pattern line from 0-4
-                if (gameModel->getCurrentPlayer()->getBoard()->canAccept(colour, destinationIndex)) {
-                    destination = gameModel->getCurrentPlayer()->getBoard()->getPatternLine(destinationIndex);
-                }
-
-            } else {
-                // floor line, can always accept tiles, excess just goes to the lid
-                destination = gameModel->getCurrentPlayer()->getBoard()->getFloorLine();
-            }
-
-            if ((unsigned int) sourceIndex < gameModel->getNumberOfFactories()) {
-                if (gameModel->getFactory(sourceIndex)->contains(colour)) {
-                    source = gameModel->getFactory(sourceIndex);
-                }
-            } else {
-                sourceIndex -= 9;
-                if ( sourceIndex < gameModel->getNumberOfCentreFactories() && gameModel->getTableCentre(sourceIndex)->contains(colour)) {
-                    sourceCentre = true;
-                    source = gameModel->getTableCentre(sourceIndex);
-                }
-            }
-            // All validation tests pass, so create the game turn
-            if (source && destination) {
-
-                int dumpIndex = -1;
-                std::string dumpIn = "";
+        action = GameAction(TURN, move);
+    }
 
-                //if sourceCentre is true no tiles will be dumped hence it does not matter which source is passed
-                if(sourceCentre) {   
-                    dumpIndex = 0;
-                }
+    return action;
+}
 
-                //if there is only 1 centre factory set the index No need to ask which factory to place into
-                if(gameModel->getNumberOfCentreFactories() == 1)
-                {
-                    dumpIndex = 0;
-                }
-                
-                while(dumpIndex < 0 || dumpIndex > 2 ) {
-                    ioHandler->printToStdOut("Which factory will you like to dump to: \n");
-                    ioHandler->readFromStdIn(dumpIn);
-                    if(dumpIn == "C" || dumpIn == "c") {
-                        dumpIndex = 0;
-                    } else if (dumpIn == "D" || dumpIn == "d") {
-                        dumpIndex = 1;
-                    }
-                    if(dumpIndex < 0 || dumpIndex > 2) {
-                        ioHandler->printToStdOut("ERROR: ");
-                    }
-                }
-                action = GameAction(TURN, make_shared<GameTurn>(source, destination, colour, gameModel->getTableCentre(dumpIndex)));
-            }
+int GameEngine::promptForDumpCentre() {
+    int dumpIndex = -1;
+    std::string dumpIn = "";
+
+    while(dumpIndex < 0) {
+        ioHandler->printToStdOut("Which factory will you like to dump to: \n");
+        ioHandler->readFromStdIn(dumpIn);
+        if(dumpIn == "C" || dumpIn == "c") {
+            dumpIndex = 0;
+        } else if (dumpIn == "D" || dumpIn == "d") {
+            dumpIndex = 1;
+        }
+        if(dumpIndex < 0) {
+            ioHandler->printToStdOut("ERROR: ");
         }
-    } catch (std::out_of_range& e) {
-
     }
-    
-    return action;
+
+    return dumpIndex;
 }
 
 GameAction GameEngine::createShowAction(std::string input)
@@ -301,7 +244,7 @@ void GameEngine::performGameAction(GameAction action) {
     if (action.type() == UNKNOWN) {
         // unknown();
     } else if (action.type() == TURN) {
-        doTurn(action.getTurn());
+        doTurn(action.getMove());
     } else if (action.type() == SHOW_MENU) {
         printMenu();
         performGameAction(promptForAction());
@@ -324,16 +267,21 @@ void GameEngine::performGameAction(GameAction action) {
 
 void GameEngine::printPlayerBoard(int playerIndex)
 {
-    vector<shared_ptr<Player>> players = gameModel->getAllPlayers();
-
-    ioHandler->printToStdOut("Name: " + players[playerIndex]->getName() + "\n" + players[playerIndex]->getBoard()->getPrintable() +"\n\n");
+    shared_ptr<Player> player = gameModel->getAllPlayers()[playerIndex];
+
+    frame.add("Name: ");
+    frame.add(player->getName());
+    frame.add('\n');
+    player->getBoard()->print(frame);
+    frame.add("\n\n");
+    ioHandler->printToStdOut(frame);
 }
 
 void GameEngine::printCommands()
 {
     std::string commands = "Commands:\n";
     commands += "Show a player's board -> show <playerName>\n";
-    commands += "To make a turn -> <source> <Tile> <destination>\n";
+    commands += "To make a turn -> <source> <Tile> <destination> [<centre>]\n";
     commands += "To get the commands list -> help\n";
     commands += "To get the menu -> menu\n";
     commands += "To save the game -> save\n";
@@ -342,328 +290,33 @@ void GameEngine::printCommands()
     ioHandler->printToStdOut(commands);
 }
 
-void GameEngine::fillFactories() {
-    shared_ptr<TileBag> bag = gameModel->getTileBag();
-    unsigned int factoryIndex = 0;
-    bool tilesAvailable = true;
-    
-    while (factoryIndex != gameModel->getNumberOfFactories() && tilesAvailable) {
-        shared_ptr<Factory> factory = gameModel->getFactory(factoryIndex);
-        int tileIndex = 0;
-
-        // Factories should take four tiles from the bag, each
-        while (tileIndex != 4 && tilesAvailable) {
-            // Check if the bag is empty
-            if (bag->getNumberOfTiles() == 0) {
-                refillTileBag();
-                if (bag->getNumberOfTiles() == 0) {
-                    // Bag and box are both empty, so stop filling and start
-                    // turn with incomplete factories
-                    tilesAvailable = false;
-                }
-            }
-
-            if (tilesAvailable) {
-                factory->add(bag->remove());
-            }
-            
-            ++tileIndex;
-        }
-
-        ++factoryIndex;
-    }
-}
-
-void GameEngine::refillTileBag() {
-    shared_ptr<TileBag> bag = gameModel->getTileBag();
-    shared_ptr<BoxLid> lid = gameModel->getBoxLid();
-    unsigned int tilesInLid = lid->getNumberOfTiles();
-    
-    for (unsigned int i = 0; i != tilesInLid; ++i) {
-        bag->add(lid->remove());
-    }
-}
-
-void GameEngine::doTurn(shared_ptr<GameTurn> turn) {
-    vector<unique_ptr<Tile>> sourceTiles = turn->getSource()->getTiles();
+void GameEngine::doTurn(Move move) {
+    MoveResult result = GameRules(*gameModel).applyMove(move);
 
-    for(int i = 0; i < gameModel->getNumberOfCentreFactories(); ++i)
-    {
-        if(turn->getSource() == gameModel->getTableCentre(i))
-        {
-            if(gameModel->isFirst())
-            {
-                gameModel->getCurrentPlayer()->getBoard()->getFloorLine()->addTile(move(gameModel->removeFirstFromTable()));
-            }
-        }
+    if (journal.isOpen() && !journal.record(move, *gameModel)) {
+        reportJournalFailure();
     }
-    
-
-
-    for (unsigned int i = 0; i != sourceTiles.size(); ++i) {
-        if (sourceTiles[i]->getColour() == turn->getColour()) {
-            // colour matches what player wants
-            if (!turn->getDestination()->isfull()) {
-                // theres room on the line, so put it there
-                turn->getDestination()->addTile(move(sourceTiles[i]));
-            } else {
-                // there's no room on the line, so put it on the floor line
-                if (!gameModel->getCurrentPlayer()->getBoard()->getFloorLine()->isfull()) {
-                    // there's room to put the tile on the floor line
-                    gameModel->getCurrentPlayer()->getBoard()->getFloorLine()->addTile(move(sourceTiles[i]));
-                } else {
-                    // the player's floor line is also full, so put it in the lid
-                    gameModel->getBoxLid()->add(move(sourceTiles[i]));
-                }
-            }
-        } else {
-            // excess tiles are moved to the table centre
-            
-            //TODO 
-            turn->getCentre()->add(move(sourceTiles[i]));
-            // gameModel->getTableCentre(0)->add(move(sourceTiles[i]));
-        }
-    }
-
-    if(endOfFactoryOffer()) {
-        doScoring();
-        if (endOfGame()) {
-            doFinalScoring();
-            declareWinner();
-        } else {
-            fillFactories();
-        }
-    } else {
-        passTurnToNextPlayer();
-    }
-}
-
-bool GameEngine::endOfFactoryOffer() {
-    // end of the round if all factories are empty
-    bool isEnd = true;
-    map<TileColour, int> counts;
-
-    isEnd = !gameModel->isFirst();
-
-    for(int i = 0; i < gameModel->getNumberOfCentreFactories() &&  isEnd; ++i) {
-        isEnd  = gameModel->getTableCentre(i)->isEmpty();
-    }
-
-    unsigned int index = 0;
-
-    while (index != gameModel->getNumberOfFactories() && isEnd) {
-        isEnd = gameModel->getFactory(index)->isEmpty();
-        ++index;
-    }
-
-    return isEnd;
-}
-
-void GameEngine::doScoring() {
-    for (shared_ptr<Player> player : gameModel->getAllPlayers()) {
-        scorePlayer(player);
-    }
-}
 
-void GameEngine::scorePlayer(shared_ptr<Player> player) {
-    // Get the current score for a player
-    int newScore = player->getScore();
-
-    // Update their score based on their pattern lines
-    newScore += scorePlayerPatternLines(player);
-
-    // Update their score based on their floor line
-    newScore += scorePlayerFloorLine(player);
-    
-    // Players don't fall below a score of 0
-    if (newScore < 0) {
-        newScore = 0;
-    }
-
-    player->setScore(newScore);
-}
-
-int GameEngine::scorePlayerPatternLines(shared_ptr<Player> player) {
-    shared_ptr<PlayerBoard> board = player->getBoard();
-    Mosaic& wall = board->getMosaic();
-
-    int score = 0;
-
-    // Calculate positive scoring from moving to the wall
-    for (unsigned int i = 0; i != 5; ++i) {
-        // check each line from top to bottom
-        shared_ptr<PatternLine> line = board->getPatternLine(i);
-
-        if (line->isfull()) {
-            // Move a single tile to the wall
-            score += wall.add(move(line->remove()), i);
-
-            // Move remaining tiles to the box lid
-            int numExcessTiles = line->getSize() - line->getSpace();
-            while (numExcessTiles != 0) {
-                gameModel->getBoxLid()->add(move(line->remove()));
-                --numExcessTiles;
-            }
-        }
-    }
-
-    return score;
-}
-
-int GameEngine::scorePlayerFloorLine(shared_ptr<Player> player) {
-    int score = 0;
-
-    // Calculate negative scoring for tiles on the floor
-    shared_ptr<PatternLine> floorline = player->getBoard()->getFloorLine();
-    int numTilesInFloor = floorline->getSize() - floorline->getSpace();
-    for (int i = 0; i != numTilesInFloor; ++i) {
-        unique_ptr<Tile> tile = floorline->remove();
-
-        // Move the tile to the correct place
-        if (tile->isStartingMarker()) {
-            // put the marker in the centre
-            gameModel->placeFirstOnTable(move(tile));
-
-            // setting current player here, so they start the next round
-            gameModel->setCurrentPlayer(player);
-        } else {
-            // All other tiles to the lid
-            gameModel->getBoxLid()->add(move(tile));
-        }
-
-        // Adjust score based on position of tile in floor line
-        if (i <= 1) {
-            score -= 1;
-        } else if (i <= 4) {
-            score -= 2;
-        } else {
-            score -= 3;
-        }
-    }
-
-    return score;
-}
-
-bool GameEngine::endOfGame() {
-    bool isEnd = false;
-
-    for (shared_ptr<Player> player : gameModel->getAllPlayers()) {
-        if (player->getBoard()->getMosaic().rowComplete()) {
-            isEnd = true;
-        }
-    }
-
-    return isEnd;
-}
-
-void GameEngine::doFinalScoring() {
-    
-    for (shared_ptr<Player> player : gameModel->getAllPlayers()) {
-        int score = player->getScore();
-        int rowsCompleted = 0;
-        
-        for (int i = 0; i != 5; ++i) {
-            // calculate any row bonuses
-            if (player->getBoard()->getMosaic().rowComplete(i)) {
-                score += 2;
-                ++rowsCompleted;
-            }
-
-            // calculate any column bonuses
-            if (player->getBoard()->getMosaic().columnCompleted(i)) {
-                score += 7;
-            }
-        }
-
-        // Set rows completed, used in the case of a tie breaker on score alone
-        player->setRowsCompleted(rowsCompleted);
-
-        // 5 colours on a wall nets 10 points per colour
-        map<TileColour, int> colourCounts;
-        player->getBoard()->getMosaic().reportTileCounts(colourCounts);
-        for (auto count : colourCounts) {
-            if (count.second == 5) {
-                score += 10;
-            }
-        }
-
-        player->setScore(score);
+    if (!gameModel->isConserved()) {
+        ioHandler->printToStdOut("Error: Game is defective.\n");
+        inProgress = false;
+    } else if (result == GAME_OVER) {
+        declareWinner();
     }
 }
 
 void GameEngine::declareWinner() {
-    shared_ptr<Player> winner = nullptr;
+    int winner = GameRules(*gameModel).getWinner();
 
-    vector<shared_ptr<Player>> players = gameModel->getAllPlayers();
-
-    //Find player with the highest score
-    int highestScore = 0;
-    vector<int> highestScoreIndex;
-    for (int i = 0; i < gameModel->getNumberOfPlayers(); ++i) {
-        if (players[i]->getScore() > highestScore) {
-            highestScoreIndex.clear();
-            highestScoreIndex.push_back(i);
-            highestScore = players[i]->getScore();
-        } else if (players[i]->getScore() == highestScore) {
-            highestScoreIndex.push_back(i);
-        }
-    }
-
-    //If scores eqaul find player with the most collumns, Declare the winnner
-    if (highestScoreIndex.size() > 1) {
-        int mostRowsCompleted = 0;
-        vector<int> mostRowsCompletedIndex;
-        for (unsigned int i = 0; i < highestScoreIndex.size(); ++i)
-        {
-            if (players[highestScoreIndex[i]]->getRowsCompleted() > mostRowsCompleted){
-                mostRowsCompletedIndex.clear();
-                mostRowsCompletedIndex.push_back(i);
-                mostRowsCompleted = players[highestScoreIndex[i]]->getRowsCompleted();
-            } else if(players[highestScoreIndex[i]]->getRowsCompleted() == mostRowsCompleted) {
-                mostRowsCompletedIndex.push_back(i);
-            }
-        }
-
-        if(mostRowsCompletedIndex.size()) {
-            //draw
-        }
-        else {
-            winner = players[mostRowsCompletedIndex[0]];
-        }
-    } else {
-        winner = players[highestScoreIndex[0]];
-    }
-
-    if (!winner) {
+    if (winner == -1) {
         ioHandler->printToStdOut("It's a draw!\n");
     } else {
-        ioHandler->printToStdOut(winner->getName() + " is the winner!\n");
+        ioHandler->printToStdOut(gameModel->getAllPlayers()[winner]->getName() + " is the winner!\n");
     }
 
     inProgress = false;
 }
 
-void GameEngine::passTurnToNextPlayer() {
-    vector<shared_ptr<Player>>& players = gameModel->getAllPlayers();
-    int currentPlayerNumber = 0;
-
-    for(int i = 0; i < gameModel->getNumberOfPlayers(); ++i)
-    {
-        if(players[i] == gameModel->getCurrentPlayer())
-        {
-            currentPlayerNumber = i;
-        }
-    }
-    if(gameModel->getNumberOfPlayers() - 1 == currentPlayerNumber)
-    {
-        gameModel->setCurrentPlayer(players[0]);
-    }
-    else
-    {
-        gameModel->setCurrentPlayer(players[++currentPlayerNumber]);
-    }
-}
-
 void GameEngine::loadGame() {
     gameModel = make_shared<GameModel>();
     ioHandler->printToStdOut(menu->getUserPrompt("\nEnter filename"));
@@ -671,17 +324,16 @@ void GameEngine::loadGame() {
 
     if(ioHandler->readFromStdIn(fileName)) {
         
-        map<string, string> rawData;
-        ioHandler->loadGameFile(rawData, fileName);
-
-        ModelBuilder modelBuilder = ModelBuilder(*gameModel);
-        modelBuilder.loadSaveData(rawData);
-
-        
+        bool valid = ModelBuilder(*gameModel).loadSaveFile(fileName);
 
-        if (gameModel->validate()) {
+        if (valid) {
             
             ioHandler->printToStdOut("Game successfully loaded.\n");
+            seatBots();
+
+            if (!journalFile.empty() && !journal.startFromPosition(*gameModel, journalFile)) {
+                reportJournalFailure();
+            }
             // Update game state
             inProgress = true;
         } else {
@@ -699,7 +351,9 @@ void GameEngine::saveGame() {
     std::string fileName;
 
     if(ioHandler->readFromStdIn(fileName)) {
-        ioHandler->printToFile(gameModel->toString(), fileName);
+        if (!saveWriter.save(*gameModel, fileName)) {
+            ioHandler->printToStdOut("Error: Could not write the save game.\n");
+        }
     } else {
         ioHandler->printToStdOut("Error: Invalid filename.\n");
     }
@@ -745,8 +399,16 @@ void GameEngine::newGame() {
         playerNames[i] = playerName;
     }
 
+    // Without a seed, pick one, so the game can still be journalled by
+    // its seed
+    int gameSeed = seed;
+    std::random_device rand;
+    while (gameSeed == numeric_limits<int>::min()) {
+        gameSeed = rand();
+    }
+
     ModelBuilder modelBuilder = ModelBuilder(*gameModel);
-    modelBuilder.createNewGame(numberOfCentralFactories, playerNames, numberOfPlayers, seed);
+    modelBuilder.createNewGame(numberOfCentralFactories, playerNames, numberOfPlayers, gameSeed);
 
     if (gameModel->validate()) {
         ioHandler->printToStdOut("Game successfully created.\n");
@@ -756,86 +418,58 @@ void GameEngine::newGame() {
         ioHandler->printToStdOut("Error: Game is defective.\n");
     }
 
-    // First player is default first turn, change to prompt for portugal thing
-    gameModel->setCurrentPlayer(gameModel->getAllPlayers()[0]);
+    // First player is default first turn, and the factories are filled
+    GameRules(*gameModel).startGame();
+    seatBots();
 
-    // Add tiles to the factories
-    fillFactories();
+    if (!journalFile.empty() && !journal.startFromSeed(*gameModel, gameSeed, journalFile)) {
+        reportJournalFailure();
+    }
 
     // Update the game state to start the game
     inProgress = true;
 }
 
-int GameEngine::getTurnSource(char sourceKey) {
-    int source = -1;
-
-    if (sourceKey == 'c' || sourceKey == 'C') {
-        source = 9;
-    } else if(sourceKey == 'd' || sourceKey == 'D') {
-        source = 10;
-    } else if (sourceKey == '1') {std::string numberOfPlayers;
-        source = 0;
-    } else if (sourceKey == '2') {
-        source = 1;
-    } else if (sourceKey == '3') {
-        source = 2;
-    } else if (sourceKey == '4') {
-        source = 3;
-    } else if (sourceKey == '5') {
-        source = 4;
-    } else if (sourceKey == '6' && gameModel->getNumberOfPlayers() >= 3) {
-        source = 5;
-    } else if (sourceKey == '7' && gameModel->getNumberOfPlayers() >= 3) {
-        source = 6;
-    } else if (sourceKey == '8' && gameModel->getNumberOfPlayers() >= 4) {
-        source = 7;
-    } else if (sourceKey == '9' && gameModel->getNumberOfPlayers() >= 4) {
-        source = 8;
-    } else {
-        // invalid source key
-    }
+void GameEngine::seatBots() {
+    bots.clear();
 
-    return source;
-}
+    for (int i = 0; i != gameModel->getNumberOfPlayers(); ++i) {
+        string& name = gameModel->getAllPlayers()[i]->getName();
+        shared_ptr<Policy> bot = nullptr;
 
-int GameEngine::getTurnDestination(char destKey) {
-    int dest = -1;
-
-    if (destKey == 'f' || destKey == 'F') {
-        dest = 5;
-    } else if (destKey == '1') {
-        dest = 0;
-    } else if (destKey == '2') {
-        dest = 1;
-    } else if (destKey == '3') {
-        dest = 2;
-    } else if (destKey == '4') {
-        dest = 3;
-    } else if (destKey == '5') {
-        dest = 4;
-    } else {
-        // invalid dest key
-    }
+        if (name.compare(0, BOT_NAME_PREFIX.size(), BOT_NAME_PREFIX) == 0) {
+            std::random_device rand;
+            unsigned int botSeed = seed != numeric_limits<int>::min() ? seed + i : rand();
 
-    return dest;
+            bot = Policy::create(name.substr(BOT_NAME_PREFIX.size()), botSeed);
+            if (!bot) {
+                ioHandler->printToStdOut("Warning: no bot called " + name + ", they will play as a person.\n");
+            }
+        }
+
+        bots.push_back(bot);
+    }
 }
 
-TileColour GameEngine::getTurnColour(char colourKey) {
-    TileColour colour = NONE;
-
-    if (colourKey == 'R' || colourKey == 'r' ) {
-        colour = RED;
-    } else if (colourKey == 'Y' || colourKey == 'y' ) {
-        colour = YELLOW;
-    } else if (colourKey == 'B' || colourKey == 'b' ) {
-        colour = DARK_BLUE;
-    } else if (colourKey == 'L' || colourKey == 'l' ) {
-        colour = LIGHT_BLUE;
-    } else if (colourKey == 'U' || colourKey == 'u' ) {
-        colour = BLACK;
+void GameEngine::playBotTurn() {
+    shared_ptr<Player> player = gameModel->getCurrentPlayer();
+    MoveGenerator moveGenerator(*gameModel);
+    Move moves[MAX_MOVES];
+    unsigned int numberOfMoves = moveGenerator.generate(moves);
+
+    if (numberOfMoves == 0) {
+        // Only possible once every tile is stuck on the boards
+        ioHandler->printToStdOut(player->getName() + " has no move to make.\n");
+        inProgress = false;
     } else {
-        // invalid colour
+        Move move = bots[gameModel->getCurrentPlayerIndex()]->chooseMove(*gameModel, moves, numberOfMoves);
+        bool showCentre = move.getSource() < CENTRE_SLOT_OFFSET && gameModel->getNumberOfCentreFactories() == 2;
+
+        ioHandler->printToStdOut(player->getName() + " plays " + move.toString(showCentre) + "\n");
+        doTurn(move);
     }
+}
 
-    return colour;
+void GameEngine::reportJournalFailure() {
+    ioHandler->printToStdOut("Warning: could not write the journal " + journalFile + ", the game will not be recorded.\n");
 }
@@ -10,11 +10,17 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "GameAction.h"
 #include "GameModel.h"
 #include "IOHandler.h"
 #include "Menu.h"
+#include "Move.h"
+#include "MoveJournal.h"
+#include "OutputFrame.h"
+#include "Policy.h"
+#include "SaveWriter.h"
 
 class GameEngine {
     public:
@@ -24,6 +30,10 @@ class GameEngine {
         // Set the seed if it has been provided
         void setSeed(int seed);
 
+        // Record each game played in a journal file, replacing it each time
+        // a game is started or loaded
+        void setJournal(const std::string& fileName);
+
         // Main entrypoint to the game
         void run();
 
@@ -51,42 +61,12 @@ class GameEngine {
         // Perform the requested action
         void performGameAction(GameAction action);
         
-        // Fill the factories from the tile bag
-        void fillFactories();
-
-        // Refill the tile bag using tiles from the lid
-        void refillTileBag();
-        
-        // Try to make a game turn
-        void doTurn(std::shared_ptr<GameTurn> turn);
-
-        // Check if end of round condition has been met
-        bool endOfFactoryOffer();
-
-        // Calculate scores and move tiles, per the game rules
-        void doScoring();
-
-        // Calculate and apply scores to each player
-        void scorePlayer(std::shared_ptr<Player> player);
-
-        // Calculate the score for a player's pattern lines
-        int scorePlayerPatternLines(std::shared_ptr<Player> player);
-
-        // Calculate the score for a players' floor line
-        int scorePlayerFloorLine(std::shared_ptr<Player> player);
-
-        // Check if the end of game condition has been met
-        bool endOfGame();
-
-        // Calculate the scores for the end of a game
-        void doFinalScoring();
+        // Play a move for the current player
+        void doTurn(Move move);
 
         // Determine a winner, display result
         void declareWinner();
 
-        // Pass control to next player
-        void passTurnToNextPlayer();
-
         // Load a saved game
         void loadGame();
         
@@ -107,6 +87,16 @@ class GameEngine {
         std::shared_ptr<IOHandler>    ioHandler;
         std::shared_ptr<Menu>         menu;
 
+        // Kept between saves, so its buffer is reused
+        SaveWriter                    saveWriter;
+
+        // Kept between turns, so each screen is built without allocating
+        OutputFrame                   frame;
+
+        // Journal of the game being played, and its file, or empty for none
+        MoveJournal                   journal;
+        std::string                   journalFile;
+
         // For generating random data
         int seed;
 
@@ -117,10 +107,20 @@ class GameEngine {
         // True while a player is currently interacting with a menu
         bool inMenu;
 
-        int getTurnSource(char sourceKey);
-        int getTurnDestination(char destKey);
-        TileColour getTurnColour(char colourKey);
-        
+        // Players seated by a bot policy, by index, or nullptr for a person
+        std::vector<std::shared_ptr<Policy>> bots;
+
+        // Ask which centre leftover tiles are dumped into, until answered
+        int promptForDumpCentre();
+
+        // Give a bot to each player named BOT_NAME_PREFIX and a policy
+        void seatBots();
+
+        // Let the current player's bot choose and play a move
+        void playBotTurn();
+
+        // Warn that the journal has stopped, after it fails to write
+        void reportJournalFailure();
 };
 
 #endif // GAME_ENGINE_H
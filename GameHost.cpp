@@ -0,0 +1,222 @@
+#include <algorithm>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "GameHost.h"
+
+using std::make_shared;
+using std::shared_ptr;
+using std::string;
+using std::vector;
+
+GameHost::GameHost() :
+    ioHandler(make_shared<IOHandler>()),
+    haveSeed(false),
+    seed(0),
+    seedStep(1),
+    gamesStarted(0)
+{}
+
+void GameHost::setSeed(int seed, int step) {
+    this->seed = seed;
+    seedStep = step;
+    haveSeed = true;
+}
+
+void GameHost::run() {
+    string line;
+    string output;
+
+    while (ioHandler->readFromStdIn(line) && !(ioHandler->eof() && line.empty())) {
+        if (!line.empty()) {
+            output.clear();
+            handle(line, output);
+            ioHandler->printToStdOut(output);
+        }
+    }
+}
+
+bool GameHost::handle(const string& line, string& output) {
+    bool valid = true;
+    string::size_type start = line.find_first_not_of(' ');
+    string::size_type end = line.find_last_not_of(" \r");
+    string trimmed = end == string::npos ? "" : line.substr(start, end + 1 - start);
+    string::size_type split = trimmed.find(' ');
+
+    if (split == string::npos) {
+        if (trimmed == "games") {
+            vector<string> rows;
+
+            listGames(rows);
+            output += getGameList(rows);
+        } else if (trimmed == "memory") {
+            output += getMemoryReport(getNumberOfGames(), getMemoryUsage());
+        } else {
+            output += "Error: Commands start with a game id.\n";
+            valid = false;
+        }
+
+        output += (valid ? HOST_OK : HOST_ERROR) + "\n";
+    } else {
+        string gameId = trimmed.substr(0, split);
+        string command = trimmed.substr(trimmed.find_first_not_of(' ', split));
+
+        if (gameId.size() > HOST_MAX_ID_LENGTH) {
+            output += "Error: Game ids are at most " + std::to_string(HOST_MAX_ID_LENGTH) + " characters.\n";
+            valid = false;
+        } else {
+            valid = handleGame(gameId, command, output);
+        }
+
+        output += gameId + " " + (valid ? HOST_OK : HOST_ERROR) + "\n";
+    }
+
+    return valid;
+}
+
+unsigned int GameHost::getNumberOfGames() {
+    return games.size();
+}
+
+size_t GameHost::getMemoryUsage() {
+    size_t bytes = sizeof(GameHost) + games.bucket_count() * sizeof(void*);
+
+    for (auto& game : games) {
+        bytes += getEntryUsage(game.first) + game.second->getMemoryUsage();
+    }
+
+    return bytes;
+}
+
+int GameHost::nextSeed() {
+    int gameSeed = seed + (int) gamesStarted * seedStep;
+
+    if (!haveSeed) {
+        std::random_device rand;
+        gameSeed = rand();
+    }
+
+    ++gamesStarted;
+
+    return gameSeed;
+}
+
+bool GameHost::handleGame(const string& gameId, const string& command, string& output) {
+    bool valid = true;
+    auto game = games.find(gameId);
+    string keyword = command.substr(0, command.find(' '));
+    string arguments = keyword.size() < command.size() ? command.substr(keyword.size() + 1) : "";
+
+    if (keyword == "new" || keyword == "load") {
+        if (game != games.end()) {
+            output += "Error: There is already a game called " + gameId + ".\n";
+            valid = false;
+        } else if (keyword == "new") {
+            valid = newGame(gameId, arguments, output);
+        } else {
+            shared_ptr<GameSession> session = make_shared<GameSession>();
+
+            valid = session->loadGame(arguments, nextSeed(), output);
+            if (valid) {
+                games[gameId] = session;
+            }
+        }
+    } else if (game == games.end()) {
+        output += "Error: There is no game called " + gameId + ".\n";
+        valid = false;
+    } else if (command == "close") {
+        games.erase(game);
+        output += "Game closed.\n";
+    } else if (command == "memory") {
+        output += "Memory: " + std::to_string(getEntryUsage(game->first) + game->second->getMemoryUsage()) + " bytes\n";
+    } else {
+        valid = game->second->handle(command, output);
+    }
+
+    return valid;
+}
+
+bool GameHost::newGame(const string& gameId, const string& arguments, string& output) {
+    std::istringstream stream(arguments);
+    int numberOfCentres = 0;
+    vector<string> playerNames;
+    string playerName;
+
+    stream >> numberOfCentres;
+    while (stream >> playerName) {
+        playerNames.push_back(playerName);
+    }
+
+    shared_ptr<GameSession> session = make_shared<GameSession>();
+    bool valid = session->newGame(numberOfCentres, playerNames, nextSeed(), output);
+
+    if (valid) {
+        games[gameId] = session;
+    }
+
+    return valid;
+}
+
+size_t GameHost::getEntryUsage(const string& gameId) {
+    // Each entry is a node holding the id, the session pointer, the next
+    // node and the id's hash
+    size_t bytes = sizeof(std::pair<const string, shared_ptr<GameSession>>) + 2 * sizeof(void*);
+    const char* start = (const char*) &gameId;
+
+    // Short ids are kept inside the string itself
+    if (gameId.data() < start || gameId.data() >= start + sizeof(gameId)) {
+        bytes += gameId.capacity() + 1;
+    }
+
+    return bytes;
+}
+
+void GameHost::listGames(vector<string>& rows) {
+    char line[HOST_MAX_ID_LENGTH + 64];
+
+    for (auto& game : games) {
+        shared_ptr<GameSession> session = game.second;
+
+        snprintf(line, sizeof(line), "%-20s %7d  %-8s %6zu\n", game.first.c_str(),
+                 session->getGameModel().getNumberOfPlayers(),
+                 session->isInProgress() ? "playing" : "over",
+                 getEntryUsage(game.first) + session->getMemoryUsage());
+        rows.push_back(line);
+    }
+}
+
+string GameHost::getGameList(vector<string>& rows) {
+    // Ids are padded with spaces, which sort before any other character
+    std::sort(rows.begin(), rows.end());
+
+    string result = "Game                 Players  State     Bytes\n";
+    for (const string& row : rows) {
+        result += row;
+    }
+
+    return result;
+}
+
+string GameHost::getMemoryReport(unsigned int numberOfGames, size_t bytes) {
+    char line[128];
+    string result;
+
+    snprintf(line, sizeof(line), "Games:          %u\n", numberOfGames);
+    result += line;
+
+    snprintf(line, sizeof(line), "Memory:         %zu bytes", bytes);
+    result += line;
+
+    if (numberOfGames != 0) {
+        snprintf(line, sizeof(line), ", %zu bytes a game", bytes / numberOfGames);
+        result += line;
+    }
+
+    result += "\n";
+
+    return result;
+}
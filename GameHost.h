@@ -0,0 +1,93 @@
+/*
+ * Game Host
+ *
+ * Holds any number of games in one process, each one a GameSession found
+ * by its game id, so a game waiting on its players costs only the memory
+ * it holds. Every command starts with the id of the game it is for:
+ *
+ *   <id> new <centres> <name> <name> [<name> <name>]
+ *   <id> load <savefile>
+ *   <id> memory
+ *   <id> close
+ *   <id> <command>     anything a game session takes, e.g. "2 y 5"
+ *
+ * A line of just "games" lists every game and the memory it holds, and
+ * "memory" gives the totals. Every reply ends with a line of the game id
+ * and HOST_OK or HOST_ERROR, or just the status for the host's own
+ * commands, so replies can be read without knowing their length.
+ *
+ * Authors: C. Hodgen (s3031209), J. Osrecak (s3782455)
+ */
+
+#ifndef GAME_HOST_H
+#define GAME_HOST_H
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "GameSession.h"
+#include "IOHandler.h"
+
+#define HOST_OK             std::string("ok")
+#define HOST_ERROR          std::string("error")
+
+// Longest game id accepted
+#define HOST_MAX_ID_LENGTH  64
+
+class GameHost {
+    public:
+        GameHost();
+
+        // Give each new game a seed counting up from this one by step,
+        // instead of a random seed. Hosts sharing out the games between
+        // them use the same step from different seeds.
+        void setSeed(int seed, int step);
+
+        // Read commands from stdin until it ends, printing each reply
+        void run();
+
+        // Run one command, adding the reply to output. Returns false if
+        // the command failed.
+        bool handle(const std::string& line, std::string& output);
+
+        unsigned int getNumberOfGames();
+
+        // Estimated bytes held by every game, and by the host to find them
+        size_t getMemoryUsage();
+
+        // Add a line for each game, with its state and memory, to rows
+        void listGames(std::vector<std::string>& rows);
+
+        // Game list from the lines of one or more hosts, sorted by game id
+        static std::string getGameList(std::vector<std::string>& rows);
+
+        // Totals for a number of games and their memory
+        static std::string getMemoryReport(unsigned int numberOfGames, size_t bytes);
+
+    private:
+        std::unordered_map<std::string, std::shared_ptr<GameSession>> games;
+        std::shared_ptr<IOHandler> ioHandler;
+
+        bool haveSeed;
+        int seed;
+        int seedStep;
+
+        // Number of games started or loaded, to give each its own seed
+        unsigned int gamesStarted;
+
+        // Seed for the next game
+        int nextSeed();
+
+        // Run a command for one game
+        bool handleGame(const std::string& gameId, const std::string& command, std::string& output);
+
+        // Start a game from "<centres> <name> <name> ..."
+        bool newGame(const std::string& gameId, const std::string& arguments, std::string& output);
+
+        // Bytes the host spends on finding a game, besides the game itself
+        size_t getEntryUsage(const std::string& gameId);
+};
+
+#endif // GAME_HOST_H
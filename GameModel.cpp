@@ -1,13 +1,16 @@
 
+#include <algorithm>
+#include <cstring>
 #include <iostream>
 #include <memory>
 
 #include "BoxLid.h"
 #include "Factory.h"
 #include "GameModel.h"
-#include "GameTurn.h"
 #include "Player.h"
+#include "SaveWriter.h"
 #include "TileBag.h"
+#include "Zobrist.h"
 
 #define MAX_PLAYERS 2
 #define MIN_PLAYERS 2
@@ -25,7 +28,9 @@ GameModel::GameModel() :
     players(vector<shared_ptr<Player>>()),
     currentPlayer(nullptr),
     factories(vector<shared_ptr<Factory>>()),
-    tableCentre(vector<shared_ptr<Factory>>())
+    tableCentre(vector<shared_ptr<Factory>>()),
+    firstOnTable(false),
+    hash(0)
 {}
 
 GameModel::~GameModel() {
@@ -77,6 +82,13 @@ bool GameModel::validate() {
     return success;
 }
 
+bool GameModel::isConserved() {
+    return ledger.isBalanced() &&
+           ledger.getCount(LEDGER_BAG) == (int) tileBag->getNumberOfTiles() &&
+           ledger.getCount(LEDGER_LID) == (int) lid->getNumberOfTiles() &&
+           ledger.getCount(LEDGER_TABLE) == (firstOnTable ? 1 : 0);
+}
+
 void GameModel::addFactory(shared_ptr<Factory> factory) {
     factories.push_back(factory);
 }
@@ -102,7 +114,33 @@ shared_ptr<Player> GameModel::getCurrentPlayer() {
 }
 
 void GameModel::setCurrentPlayer(shared_ptr<Player> player) {
+    int index = getCurrentPlayerIndex();
+    if (index != -1) {
+        hash ^= Zobrist::toMove(index);
+    }
+
     currentPlayer = player;
+
+    index = getCurrentPlayerIndex();
+    if (index != -1) {
+        hash ^= Zobrist::toMove(index);
+    }
+}
+
+int GameModel::getCurrentPlayerIndex() {
+    return getPlayerIndex(currentPlayer);
+}
+
+int GameModel::getPlayerIndex(shared_ptr<Player> player) {
+    int index = -1;
+
+    for (unsigned int i = 0; i != players.size() && index == -1; ++i) {
+        if (players[i] == player) {
+            index = i;
+        }
+    }
+
+    return index;
 }
 
 vector<shared_ptr<Player>>& GameModel::getAllPlayers() {
@@ -129,82 +167,187 @@ shared_ptr<Factory> GameModel::getTableCentre(int i) {
     return tableCentre[i];
 }
 
+int GameModel::getFactorySlot(shared_ptr<Factory> factory) {
+    int slot = -1;
+
+    for (unsigned int i = 0; i != factories.size() && slot == -1; ++i) {
+        if (factories[i] == factory) {
+            slot = i;
+        }
+    }
+
+    for (unsigned int i = 0; i != tableCentre.size() && slot == -1; ++i) {
+        if (tableCentre[i] == factory) {
+            slot = CENTRE_SLOT_OFFSET + i;
+        }
+    }
+
+    return slot;
+}
+
 std::unique_ptr<Tile> GameModel::removeFirstFromTable() {
-    return move(firstTile);
+    std::unique_ptr<Tile> tile = nullptr;
+
+    if (firstOnTable) {
+        tile = std::make_unique<Tile>(FIRST);
+        setFirstOnTable(false);
+    }
+
+    return tile;
 }
 
 bool GameModel::isFirst() {
-    bool exists = true;
+    return firstOnTable;
+}
 
-    if(firstTile == nullptr)
-    {
-        exists = false;
+void GameModel::setFirstOnTable(bool onTable) {
+    if (firstOnTable != onTable) {
+        hash ^= Zobrist::firstOnTable();
     }
 
-    return exists;
+    firstOnTable = onTable;
 }
 
 void GameModel::placeFirstOnTable(std::unique_ptr<Tile> tile)
 {
-    firstTile = std::move(tile);
+    setFirstOnTable(tile != nullptr && tile->isStartingMarker());
 }
 
 std::string GameModel::toString() {
-    string result = "";
-    string currentPlayerId = "";
+    SaveWriter writer;
+    writer.write(*this);
+
+    return writer.toString();
+}
 
-    // Print bag and lid
-    result += BAG_KEY + KEY_VALUE_DELIMITER + tileBag->toString() + "\n";
-    result += LID_KEY + KEY_VALUE_DELIMITER + lid->toString() + "\n";
+std::string GameModel::getPrintable() {
+    OutputFrame frame(true);
 
-    for(unsigned int i = 0; i < tableCentre.size(); ++i)
-    {
-        // Print table centre
-    result += FACTORY_KEY + KEY_SPLIT_DELIMITER + CENTRE_KEY + KEY_SPLIT_DELIMITER + to_string(i) + KEY_VALUE_DELIMITER + tableCentre[i]->toString() + "\n";
+    print(frame);
+
+    return frame.toString();
+}
+
+void GameModel::print(OutputFrame& frame) {
+    frame.add("\nTable Centre\nC: ");
+    tableCentre[0]->print(frame);
+    frame.add('\n');
+
+    if (tableCentre.size() == 2) {
+        frame.add("D: ");
+        tableCentre[1]->print(frame);
+        frame.add('\n');
     }
-    //print the table if FIRST tile has not been claimed
-    if(isFirst()) {
-        result += TABLE_KEY + KEY_VALUE_DELIMITER + "F\n";
-    } else {
-        result += TABLE_KEY + KEY_VALUE_DELIMITER + "\n";
+
+    if (firstOnTable) {
+        frame.addTile(FIRST);
+        frame.add('\n');
     }
 
-    // Print factories
+    frame.add("\nFactories\n");
     for (unsigned int i = 0; i != factories.size(); ++i) {
-        result += FACTORY_KEY + KEY_SPLIT_DELIMITER + to_string(i) + KEY_VALUE_DELIMITER + factories[i]->toString() + "\n";
+        frame.add((int) i + 1);
+        frame.add(": ");
+        factories[i]->print(frame);
+        frame.add('\n');
     }
 
-    for (unsigned int playerId = 0; playerId != players.size(); ++playerId) {
-        if (players[playerId] == currentPlayer) {
-            currentPlayerId = to_string(playerId);
+    frame.add("\nCurrent Player\n");
+    currentPlayer->print(frame);
+    frame.add("\n\n");
+}
+
+size_t GameModel::getMemoryUsage() {
+    size_t bytes = sizeof(GameModel);
+
+    bytes += 2 * SHARED_BLOCK_SIZE + sizeof(TileBag) + sizeof(BoxLid);
+    bytes += players.capacity() * sizeof(shared_ptr<Player>);
+    for (shared_ptr<Player>& player : players) {
+        bytes += player->getMemoryUsage();
+    }
+
+    bytes += (factories.capacity() + tableCentre.capacity()) * sizeof(shared_ptr<Factory>);
+    bytes += (factories.size() + tableCentre.size()) * (SHARED_BLOCK_SIZE + sizeof(Factory));
+
+    return bytes;
+}
+
+void GameModel::saveState(GameState& state) {
+    // Clear everything first, so unused space is always zero and two
+    // snapshots of the same game compare equal byte for byte
+    std::memset(&state, 0, sizeof(GameState));
+
+    state.numberOfPlayers = std::min<unsigned int>(players.size(), MAX_STATE_PLAYERS);
+    state.numberOfFactories = std::min<unsigned int>(factories.size(), MAX_STATE_FACTORIES);
+    state.numberOfCentres = std::min<unsigned int>(tableCentre.size(), MAX_STATE_CENTRES);
+    state.firstOnTable = firstOnTable;
+
+    state.bag.length = tileBag->getNumberOfTiles();
+    for (unsigned int i = 0; i != state.bag.length; ++i) {
+        state.bag.set(i, tileBag->getTile(i));
+    }
+
+    state.lid.length = lid->getNumberOfTiles();
+    for (unsigned int i = 0; i != state.lid.length; ++i) {
+        state.lid.set(i, lid->getTile(i));
+    }
+
+    for (unsigned int i = 0; i != state.numberOfFactories; ++i) {
+        for (unsigned int colour = 0; colour != NUMBER_OF_COLOURS; ++colour) {
+            state.setFactoryCount(i, (TileColour) colour, factories[i]->count((TileColour) colour));
+        }
+    }
+
+    for (unsigned int i = 0; i != state.numberOfCentres; ++i) {
+        for (unsigned int colour = 0; colour != NUMBER_OF_COLOURS; ++colour) {
+            state.centres[i][colour] = tableCentre[i]->count((TileColour) colour);
         }
+    }
 
-        // Print player name
-        result += PLAYER_KEY + KEY_SPLIT_DELIMITER + to_string(playerId) +
-                  KEY_SPLIT_DELIMITER + PLAYER_NAME_KEY + KEY_VALUE_DELIMITER +
-                  players[playerId]->getName() + "\n";
+    for (unsigned int playerId = 0; playerId != state.numberOfPlayers; ++playerId) {
+        PlayerState& playerState = state.players[playerId];
+        shared_ptr<PlayerBoard> board = players[playerId]->getBoard();
 
-        // Print player score
-        result += PLAYER_KEY + KEY_SPLIT_DELIMITER + to_string(playerId) + KEY_SPLIT_DELIMITER + PLAYER_SCORE_KEY + KEY_VALUE_DELIMITER + to_string(players[playerId]->getScore()) + "\n";
-        
-        // Print player pattern lines
-        for (int i = 0; i != 5; ++i) {
-            result += PLAYER_KEY + KEY_SPLIT_DELIMITER + to_string(playerId) + KEY_SPLIT_DELIMITER + PLAYER_PATTERN_KEY + KEY_SPLIT_DELIMITER + to_string(i) + KEY_VALUE_DELIMITER + players[playerId]->getBoard()->getPatternLine(i)->toString() + "\n";
+        if (players[playerId] == currentPlayer) {
+            state.currentPlayer = playerId;
         }
 
-        // Print player floor line
-        result += PLAYER_KEY + KEY_SPLIT_DELIMITER + to_string(playerId) + KEY_SPLIT_DELIMITER + PLAYER_FLOOR_KEY + KEY_VALUE_DELIMITER +players[playerId]->getBoard()->getFloorLine()->toString() + "\n";
+        playerState.wall = board->getMosaic().getWall();
+        playerState.score = players[playerId]->getScore();
 
-        // Print player wall
-        for (int i = 0; i != 5; ++i) {
-            result += "PLAYER_" + to_string(playerId) + "_MOSAIC_" + to_string(i) + "=" + players[playerId]->getBoard()->getMosaic().toString(i) + "\n";
+        for (int row = 0; row != 5; ++row) {
+            playerState.lineCount[row] = board->getPatternLine(row)->getNumberOfTiles();
+            playerState.lineColour[row] = board->getPatternLine(row)->getColour();
         }
 
-        
+        shared_ptr<FloorLine> floorLine = board->getFloorLine();
+        playerState.floorCount = floorLine->getNumberOfTiles();
+        for (unsigned int i = 0; i != playerState.floorCount; ++i) {
+            playerState.floor[i] = floorLine->getTile(i);
+        }
     }
+}
 
-    // Print current player id
-    result += CURRENT_PLAYER_KEY + KEY_VALUE_DELIMITER + currentPlayerId + "\n";
+uint64_t GameModel::getHash() {
+    return hash;
+}
+
+uint64_t GameModel::getCanonicalHash() {
+    return hash ^ Zobrist::table(*this) ^ Zobrist::unorderedTable(*this);
+}
+
+void GameModel::updateHash(uint64_t key) {
+    hash ^= key;
+}
+
+void GameModel::refreshHash() {
+    hash = Zobrist::hash(*this);
+}
+
+TileLedger& GameModel::getLedger() {
+    return ledger;
+}
 
-    return result;
+void GameModel::refreshLedger() {
+    ledger.recount(*this);
 }
@@ -10,6 +10,7 @@
 
 #define KEY_VALUE_DELIMITER std::string("=")
 #define KEY_SPLIT_DELIMITER std::string("_")
+#define COMMENT_MARKER      '#'
 #define BAG_KEY             std::string("BAG")
 #define LID_KEY             std::string("LID")
 #define PLAYER_KEY          std::string("PLAYER")
@@ -23,13 +24,21 @@
 #define CENTRE_KEY          std::string("CENTRE")
 #define TABLE_KEY           std::string("TABLE")
 
+// Factories and centres share one numbering, with the centres after the
+// largest possible number of factories
+#define CENTRE_SLOT_OFFSET  9
+
+#include <cstdint>
 #include <memory>
 #include <vector>
 
 #include "BoxLid.h"
 #include "Factory.h"
+#include "GameState.h"
+#include "OutputFrame.h"
 #include "Player.h"
 #include "TileBag.h"
+#include "TileLedger.h"
 
 class GameModel {
     public:
@@ -42,9 +51,15 @@ class GameModel {
         // Get the minimum number of players supported
         int getMinPlayers();
 
-        // Checks the game state to ensure total number of tiles is correct
+        // Checks the game state to ensure total number of tiles is correct,
+        // by counting every tile in the game
         bool validate();
 
+        // The same check in constant time, from the tile ledger, along with
+        // the sizes of the bag and lid and the first player marker against
+        // it. Relies on the ledger being kept up to date by the rules.
+        bool isConserved();
+
         // Add a factory to the model
         void addFactory(std::shared_ptr<Factory> factory);
 
@@ -63,6 +78,12 @@ class GameModel {
 
         void setCurrentPlayer(std::shared_ptr<Player> player);
 
+        // Index of the current player, or -1 if there isn't one
+        int getCurrentPlayerIndex();
+
+        // Index of a player, or -1 if they are not in the game
+        int getPlayerIndex(std::shared_ptr<Player> player);
+
         std::vector<std::shared_ptr<Player>>& getAllPlayers();
 
         std::shared_ptr<TileBag> getTileBag();
@@ -75,15 +96,56 @@ class GameModel {
 
         std::shared_ptr<Factory> getTableCentre(int i);
 
+        // Slot of a factory or centre: factories are numbered from 0, and
+        // centres from CENTRE_SLOT_OFFSET. Returns -1 if not part of the game.
+        int getFactorySlot(std::shared_ptr<Factory> factory);
+
         void placeFirstOnTable(std::unique_ptr<Tile> tile);
 
         std::unique_ptr<Tile> removeFirstFromTable();
 
         bool isFirst();
 
+        // Put the first player marker on the table, or take it off
+        void setFirstOnTable(bool onTable);
+
         // Used when saving a game
         std::string toString();
 
+        // Coloured view of the table and the current player, as shown before
+        // each turn
+        std::string getPrintable();
+
+        // Add the same view to a screen
+        void print(OutputFrame& frame);
+
+        // Estimated bytes held by the game, including every object it owns.
+        // Allocator overhead is not counted.
+        size_t getMemoryUsage();
+
+        // Take a flat snapshot of the game, excluding player names
+        void saveState(GameState& state);
+
+        // Zobrist key of the current position
+        uint64_t getHash();
+
+        // Zobrist key of the position, the same for every ordering of the
+        // factories and of the centres. Searches use it to share results
+        // between positions that only differ in which factory is which.
+        uint64_t getCanonicalHash();
+
+        // XOR a key into the position key, to account for a change
+        void updateHash(uint64_t key);
+
+        // Recompute the position key from scratch
+        void refreshHash();
+
+        // Where every tile is, kept up to date by whoever moves tiles
+        TileLedger& getLedger();
+
+        // Recount the tile ledger from scratch
+        void refreshLedger();
+
     private:
         // Game data
         std::shared_ptr<TileBag> tileBag;
@@ -93,7 +155,13 @@ class GameModel {
         std::vector<std::shared_ptr<Factory>> factories;
         std::vector<std::shared_ptr<Factory>> tableCentre;
 
-        std::unique_ptr<Tile> firstTile;     
+        // True while the first player marker is on the table
+        bool firstOnTable;
+
+        // Zobrist key, kept up to date by whoever changes the game
+        uint64_t hash;
+
+        TileLedger ledger;
 
 };
 
@@ -0,0 +1,592 @@
+#include <cassert>
+#include <memory>
+#include <vector>
+
+#include "GameRules.h"
+#include "ModelBuilder.h"
+#include "Types.h"
+#include "Zobrist.h"
+
+using std::shared_ptr;
+using std::vector;
+
+GameRules::GameRules(GameModel& gameModel) :
+    gameModel(gameModel)
+{}
+
+MoveResult GameRules::applyMove(Move move) {
+    MoveResult result = MOVE_PLAYED;
+    shared_ptr<PlayerBoard> board = gameModel.getCurrentPlayer()->getBoard();
+    shared_ptr<FloorLine> floorLine = board->getFloorLine();
+    shared_ptr<BoxLid> lid = gameModel.getBoxLid();
+    shared_ptr<Factory> source = getSource(move.getSource());
+    shared_ptr<PatternLine> destination = getDestination(board, move.getDestination());
+    TileColour colour = move.getColour();
+
+    MoveRecord record;
+    record.hash = gameModel.getHash();
+    record.move = move;
+    record.player = gameModel.getCurrentPlayerIndex();
+    record.lineCount = destination->getNumberOfTiles();
+    record.floorCount = floorLine->getNumberOfTiles();
+    record.lidSize = lid->getNumberOfTiles();
+    record.firstOnTable = gameModel.isFirst();
+    record.roundEnded = false;
+    record.bumped = NONE;
+
+    for (unsigned int i = 0; i != NUMBER_OF_COLOURS; ++i) {
+        record.sourceCounts[i] = source->count((TileColour) i);
+    }
+
+    unsigned int taken = 0;
+    TileLedger& ledger = gameModel.getLedger();
+    TileLocation from = move.getSource() >= CENTRE_SLOT_OFFSET ? LEDGER_CENTRES : LEDGER_FACTORIES;
+
+    // Take the parts of the position this move touches out of the key, and
+    // put them back once the tiles have moved
+    gameModel.updateHash(moveKey(move));
+
+    if (move.getSource() >= CENTRE_SLOT_OFFSET) {
+        if (gameModel.isFirst()) {
+            gameModel.setFirstOnTable(false);
+
+            // The marker always goes to the floor line, so if it is full
+            // the last tile on it makes way, and goes to the lid
+            if (floorLine->getSpace() == 0) {
+                TileColour bumped = floorLine->removeTile();
+                lid->add(bumped);
+                ledger.move(LEDGER_FLOOR_LINES, LEDGER_LID, bumped, 1);
+                record.bumped = bumped;
+            }
+
+            floorLine->addTile(FIRST);
+            ledger.move(LEDGER_TABLE, LEDGER_FLOOR_LINES, FIRST, 1);
+        }
+
+        // tiles of other colours stay where they are
+        taken = source->take(colour);
+    } else {
+        // excess tiles are moved to the table centre
+        taken = source->take(colour, *gameModel.getTableCentre(move.getDumpCentre()));
+
+        for (unsigned int i = 0; i != NUMBER_OF_COLOURS; ++i) {
+            if (i != (unsigned int) colour) {
+                ledger.move(LEDGER_FACTORIES, LEDGER_CENTRES, (TileColour) i, record.sourceCounts[i]);
+            }
+        }
+    }
+
+    // fill the chosen line, then the floor line, and whatever is left over
+    // goes to the lid
+    unsigned int excess = destination->addTiles(colour, taken);
+    unsigned int overflow = floorLine->addTiles(colour, excess);
+
+    for (unsigned int i = 0; i != overflow; ++i) {
+        lid->add(colour);
+    }
+
+    ledger.move(from, move.getDestination() == MOVE_FLOOR_LINE ? LEDGER_FLOOR_LINES : LEDGER_PATTERN_LINES, colour, taken - excess);
+    ledger.move(from, LEDGER_FLOOR_LINES, colour, excess - overflow);
+    ledger.move(from, LEDGER_LID, colour, overflow);
+
+    gameModel.updateHash(moveKey(move));
+
+    if (endOfFactoryOffer()) {
+        // Scoring and the refill touch every board, the lid and the bag, so
+        // keep the whole position rather than a delta
+        GameState state;
+        gameModel.saveState(state);
+        roundStates.push_back(state);
+        record.roundEnded = true;
+
+        doScoring();
+        if (endOfGame()) {
+            doFinalScoring();
+            result = GAME_OVER;
+        } else {
+            fillFactories();
+            result = ROUND_OVER;
+        }
+    } else {
+        passTurnToNextPlayer();
+    }
+
+    history.push_back(record);
+
+#ifdef LEDGER_CROSS_CHECK
+    // Checked builds recount every tile, to catch the ledger and the rules
+    // disagreeing
+    assert(gameModel.isConserved() && gameModel.getLedger().matches(gameModel));
+#endif
+
+    return result;
+}
+
+bool GameRules::endsRound(Move move) {
+    shared_ptr<Factory> source = getSource(move.getSource());
+    unsigned int onTable = 0;
+
+    for (unsigned int i = 0; i != gameModel.getNumberOfFactories(); ++i) {
+        onTable += gameModel.getFactory(i)->size();
+    }
+
+    for (int i = 0; i != gameModel.getNumberOfCentreFactories(); ++i) {
+        onTable += gameModel.getTableCentre(i)->size();
+    }
+
+    // Only the chosen tiles may be left, and the marker goes with any take
+    // from a centre
+    return onTable == source->count(move.getColour()) &&
+           (!gameModel.isFirst() || move.getSource() >= CENTRE_SLOT_OFFSET);
+}
+
+void GameRules::undoMove() {
+    if (!history.empty()) {
+        const MoveRecord& record = history.back();
+        Move move = record.move;
+
+        if (record.roundEnded) {
+            ModelBuilder(gameModel).loadState(roundStates.back());
+            roundStates.pop_back();
+        }
+
+        gameModel.setCurrentPlayer(gameModel.getAllPlayers()[record.player]);
+
+        shared_ptr<PlayerBoard> board = gameModel.getCurrentPlayer()->getBoard();
+        shared_ptr<FloorLine> floorLine = board->getFloorLine();
+        shared_ptr<BoxLid> lid = gameModel.getBoxLid();
+        shared_ptr<Factory> source = getSource(move.getSource());
+        shared_ptr<PatternLine> destination = getDestination(board, move.getDestination());
+
+        TileLedger& ledger = gameModel.getLedger();
+        TileLocation to = move.getSource() >= CENTRE_SLOT_OFFSET ? LEDGER_CENTRES : LEDGER_FACTORIES;
+
+        // A search may have shuffled the lid since this move, so tiles that
+        // went to it are taken back by colour rather than from the end.
+        // A tile pushed off the floor line by the marker goes back in place
+        // of the marker.
+        if (record.bumped != NONE) {
+            TileColour bumped = (TileColour) record.bumped;
+
+            lid->removeLast(bumped);
+            floorLine->removeTile();
+            floorLine->addTile(bumped);
+            ledger.move(LEDGER_FLOOR_LINES, LEDGER_TABLE, FIRST, 1);
+            ledger.move(LEDGER_LID, LEDGER_FLOOR_LINES, bumped, 1);
+        }
+
+        ledger.move(LEDGER_LID, to, move.getColour(), lid->getNumberOfTiles() - record.lidSize);
+        while (lid->getNumberOfTiles() > record.lidSize) {
+            lid->removeLast(move.getColour());
+        }
+
+        // Tiles only ever go on the end of the lines, so take them back off
+        // the end
+
+        while (floorLine->getNumberOfTiles() > record.floorCount) {
+            TileColour colour = floorLine->removeTile();
+            ledger.move(LEDGER_FLOOR_LINES, colour == FIRST ? LEDGER_TABLE : to, colour, 1);
+        }
+
+        ledger.move(LEDGER_PATTERN_LINES, to, move.getColour(), destination->getNumberOfTiles() - record.lineCount);
+        while (destination->getNumberOfTiles() > record.lineCount) {
+            destination->removeTile();
+        }
+
+        // Leftovers from a factory went to the dump centre
+        if (move.getSource() < CENTRE_SLOT_OFFSET) {
+            shared_ptr<Factory> centre = gameModel.getTableCentre(move.getDumpCentre());
+
+            for (unsigned int i = 0; i != NUMBER_OF_COLOURS; ++i) {
+                if (i != (unsigned int) move.getColour()) {
+                    centre->remove((TileColour) i, record.sourceCounts[i]);
+                    ledger.move(LEDGER_CENTRES, LEDGER_FACTORIES, (TileColour) i, record.sourceCounts[i]);
+                }
+            }
+        }
+
+        source->clear();
+        for (unsigned int i = 0; i != NUMBER_OF_COLOURS; ++i) {
+            source->add((TileColour) i, record.sourceCounts[i]);
+        }
+
+        gameModel.setFirstOnTable(record.firstOnTable);
+
+        // Every change above toggled the key, so set it back in one go
+        gameModel.updateHash(gameModel.getHash() ^ record.hash);
+
+        history.pop_back();
+    }
+
+#ifdef LEDGER_CROSS_CHECK
+    // Checked builds recount every tile, to catch the ledger and the rules
+    // disagreeing
+    assert(gameModel.isConserved() && gameModel.getLedger().matches(gameModel));
+#endif
+}
+
+unsigned int GameRules::getHistorySize() {
+    return history.size();
+}
+
+void GameRules::clearHistory() {
+    history.clear();
+    roundStates.clear();
+}
+
+void GameRules::startGame() {
+    gameModel.setCurrentPlayer(gameModel.getAllPlayers()[0]);
+    fillFactories();
+}
+
+void GameRules::fillFactories() {
+    shared_ptr<TileBag> bag = gameModel.getTileBag();
+    unsigned int factoryIndex = 0;
+    bool tilesAvailable = true;
+
+    while (factoryIndex != gameModel.getNumberOfFactories() && tilesAvailable) {
+        shared_ptr<Factory> factory = gameModel.getFactory(factoryIndex);
+        int tileIndex = 0;
+
+        // Factories should take four tiles from the bag, each
+        while (tileIndex != 4 && tilesAvailable) {
+            // Check if the bag is empty
+            if (bag->getNumberOfTiles() == 0) {
+                refillTileBag();
+                if (bag->getNumberOfTiles() == 0) {
+                    // Bag and box are both empty, so stop filling and start
+                    // turn with incomplete factories
+                    tilesAvailable = false;
+                }
+            }
+
+            if (tilesAvailable) {
+                TileColour colour = bag->draw();
+                factory->add(colour);
+                gameModel.getLedger().move(LEDGER_BAG, LEDGER_FACTORIES, colour, 1);
+
+                // Swap the old counts for the new ones in the position key
+                unsigned int inBag = bag->getNumberOfTiles(colour);
+                unsigned int inFactory = factory->count(colour);
+                gameModel.updateHash(Zobrist::bagCount(colour, inBag + 1) ^
+                                     Zobrist::bagCount(colour, inBag) ^
+                                     Zobrist::factoryCount(factoryIndex, colour, inFactory - 1) ^
+                                     Zobrist::factoryCount(factoryIndex, colour, inFactory));
+            }
+
+            ++tileIndex;
+        }
+
+        ++factoryIndex;
+    }
+}
+
+void GameRules::refillTileBag() {
+    shared_ptr<TileBag> bag = gameModel.getTileBag();
+    shared_ptr<BoxLid> lid = gameModel.getBoxLid();
+    unsigned int tilesInLid = lid->getNumberOfTiles();
+    uint64_t key = Zobrist::bag(*bag) ^ Zobrist::lid(*lid);
+
+    for (unsigned int i = 0; i != tilesInLid; ++i) {
+        TileColour colour = lid->draw();
+        bag->add(colour);
+        gameModel.getLedger().move(LEDGER_LID, LEDGER_BAG, colour, 1);
+    }
+
+    gameModel.updateHash(key ^ Zobrist::bag(*bag) ^ Zobrist::lid(*lid));
+}
+
+bool GameRules::endOfFactoryOffer() {
+    // end of the round if all factories are empty
+    bool isEnd = !gameModel.isFirst();
+
+    for (int i = 0; i < gameModel.getNumberOfCentreFactories() && isEnd; ++i) {
+        isEnd = gameModel.getTableCentre(i)->isEmpty();
+    }
+
+    unsigned int index = 0;
+
+    while (index != gameModel.getNumberOfFactories() && isEnd) {
+        isEnd = gameModel.getFactory(index)->isEmpty();
+        ++index;
+    }
+
+    return isEnd;
+}
+
+void GameRules::doScoring() {
+    for (shared_ptr<Player> player : gameModel.getAllPlayers()) {
+        scorePlayer(player);
+    }
+}
+
+void GameRules::scorePlayer(shared_ptr<Player> player) {
+    int playerIndex = gameModel.getPlayerIndex(player);
+    uint64_t key = playerKey(playerIndex) ^ Zobrist::lid(*gameModel.getBoxLid());
+
+    // Get the current score for a player
+    int newScore = player->getScore();
+
+    // Update their score based on their pattern lines
+    newScore += scorePlayerPatternLines(player);
+
+    // Update their score based on their floor line
+    newScore += scorePlayerFloorLine(player);
+
+    // Players don't fall below a score of 0
+    if (newScore < 0) {
+        newScore = 0;
+    }
+
+    player->setScore(newScore);
+
+    gameModel.updateHash(key ^ playerKey(playerIndex) ^ Zobrist::lid(*gameModel.getBoxLid()));
+}
+
+int GameRules::scorePlayerPatternLines(shared_ptr<Player> player) {
+    shared_ptr<PlayerBoard> board = player->getBoard();
+    Mosaic& wall = board->getMosaic();
+
+    int score = 0;
+
+    // Calculate positive scoring from moving to the wall
+    for (unsigned int i = 0; i != 5; ++i) {
+        // check each line from top to bottom
+        shared_ptr<PatternLine> line = board->getPatternLine(i);
+
+        if (line->isfull()) {
+            TileLedger& ledger = gameModel.getLedger();
+            ledger.move(LEDGER_PATTERN_LINES, LEDGER_WALLS, line->getColour(), 1);
+            ledger.move(LEDGER_PATTERN_LINES, LEDGER_LID, line->getColour(), line->getNumberOfTiles() - 1);
+
+            // Move a single tile to the wall, and the rest to the box lid
+            score += line->addToWall(wall, i, gameModel.getBoxLid());
+        }
+    }
+
+    return score;
+}
+
+int GameRules::scorePlayerFloorLine(shared_ptr<Player> player) {
+    // Calculate negative scoring for tiles on the floor
+    shared_ptr<PatternLine> floorline = player->getBoard()->getFloorLine();
+    int numTilesInFloor = floorline->getSize() - floorline->getSpace();
+    for (int i = 0; i != numTilesInFloor; ++i) {
+        TileColour colour = floorline->removeTile();
+
+        // Move the tile to the correct place
+        if (colour == FIRST) {
+            // put the marker in the centre
+            gameModel.setFirstOnTable(true);
+            gameModel.getLedger().move(LEDGER_FLOOR_LINES, LEDGER_TABLE, FIRST, 1);
+
+            // setting current player here, so they start the next round
+            gameModel.setCurrentPlayer(player);
+        } else {
+            // All other tiles to the lid
+            gameModel.getBoxLid()->add(colour);
+            gameModel.getLedger().move(LEDGER_FLOOR_LINES, LEDGER_LID, colour, 1);
+        }
+    }
+
+    return -getFloorPenalty(numTilesInFloor);
+}
+
+int GameRules::getProjectedScore(int playerIndex) {
+    shared_ptr<Player> player = gameModel.getAllPlayers()[playerIndex];
+    shared_ptr<PlayerBoard> board = player->getBoard();
+
+    // Score full lines against a copy of the wall, so that tiles placed
+    // earlier in the round count towards the later ones
+    Mosaic wall = board->getMosaic();
+    int score = player->getScore();
+
+    for (int row = 0; row != 5; ++row) {
+        shared_ptr<PatternLine> line = board->getPatternLine(row);
+
+        if (line->isfull()) {
+            score += wall.add(line->getColour(), row);
+        }
+    }
+
+    score -= getFloorPenalty(board->getFloorLine()->getNumberOfTiles());
+
+    // Players don't fall below a score of 0
+    if (score < 0) {
+        score = 0;
+    }
+
+    return score;
+}
+
+int GameRules::getFloorPenalty(int numberOfTiles) {
+    int penalty = 0;
+
+    // Adjust score based on position of tile in floor line
+    for (int i = 0; i < numberOfTiles; ++i) {
+        if (i <= 1) {
+            penalty += 1;
+        } else if (i <= 4) {
+            penalty += 2;
+        } else {
+            penalty += 3;
+        }
+    }
+
+    return penalty;
+}
+
+bool GameRules::endOfGame() {
+    bool isEnd = false;
+
+    for (shared_ptr<Player> player : gameModel.getAllPlayers()) {
+        if (player->getBoard()->getMosaic().rowComplete()) {
+            isEnd = true;
+        }
+    }
+
+    return isEnd;
+}
+
+void GameRules::doFinalScoring() {
+    for (shared_ptr<Player> player : gameModel.getAllPlayers()) {
+        Mosaic& mosaic = player->getBoard()->getMosaic();
+        int rowsCompleted = mosaic.getCompletedRows();
+
+        // 2 points a row, 7 a column, and 10 for each colour with all 5
+        // tiles on the wall
+        int score = player->getScore() + 2 * rowsCompleted + 7 * mosaic.getCompletedColumns() +
+                    10 * mosaic.getCompletedColours();
+
+        // Set rows completed, used in the case of a tie breaker on score alone
+        player->setRowsCompleted(rowsCompleted);
+
+        int playerIndex = gameModel.getPlayerIndex(player);
+        gameModel.updateHash(Zobrist::score(playerIndex, player->getScore()) ^
+                             Zobrist::score(playerIndex, score));
+
+        player->setScore(score);
+    }
+}
+
+void GameRules::passTurnToNextPlayer() {
+    vector<shared_ptr<Player>>& players = gameModel.getAllPlayers();
+    int nextPlayer = gameModel.getCurrentPlayerIndex() + 1;
+
+    if (nextPlayer == gameModel.getNumberOfPlayers()) {
+        nextPlayer = 0;
+    }
+
+    gameModel.setCurrentPlayer(players[nextPlayer]);
+}
+
+int GameRules::getWinner() {
+    int winner = -1;
+
+    vector<shared_ptr<Player>>& players = gameModel.getAllPlayers();
+
+    //Find player with the highest score
+    int highestScore = 0;
+    vector<int> highestScoreIndex;
+    for (int i = 0; i < gameModel.getNumberOfPlayers(); ++i) {
+        if (players[i]->getScore() > highestScore) {
+            highestScoreIndex.clear();
+            highestScoreIndex.push_back(i);
+            highestScore = players[i]->getScore();
+        } else if (players[i]->getScore() == highestScore) {
+            highestScoreIndex.push_back(i);
+        }
+    }
+
+    //If scores eqaul find player with the most collumns, Declare the winnner
+    if (highestScoreIndex.size() > 1) {
+        int mostRowsCompleted = 0;
+        vector<int> mostRowsCompletedIndex;
+        for (unsigned int i = 0; i < highestScoreIndex.size(); ++i)
+        {
+            if (players[highestScoreIndex[i]]->getRowsCompleted() > mostRowsCompleted){
+                mostRowsCompletedIndex.clear();
+                mostRowsCompletedIndex.push_back(i);
+                mostRowsCompleted = players[highestScoreIndex[i]]->getRowsCompleted();
+            } else if(players[highestScoreIndex[i]]->getRowsCompleted() == mostRowsCompleted) {
+                mostRowsCompletedIndex.push_back(i);
+            }
+        }
+
+        if(mostRowsCompletedIndex.size()) {
+            //draw
+        }
+        else {
+            winner = highestScoreIndex[mostRowsCompletedIndex[0]];
+        }
+    } else {
+        winner = highestScoreIndex[0];
+    }
+
+    return winner;
+}
+
+shared_ptr<Factory> GameRules::getSource(int slot) {
+    shared_ptr<Factory> source = nullptr;
+
+    if (slot >= CENTRE_SLOT_OFFSET) {
+        source = gameModel.getTableCentre(slot - CENTRE_SLOT_OFFSET);
+    } else {
+        source = gameModel.getFactory(slot);
+    }
+
+    return source;
+}
+
+shared_ptr<PatternLine> GameRules::getDestination(shared_ptr<PlayerBoard> board, int destination) {
+    shared_ptr<PatternLine> line = nullptr;
+
+    if (destination == MOVE_FLOOR_LINE) {
+        line = board->getFloorLine();
+    } else {
+        line = board->getPatternLine(destination);
+    }
+
+    return line;
+}
+
+uint64_t GameRules::moveKey(Move move) {
+    int playerIndex = gameModel.getCurrentPlayerIndex();
+    shared_ptr<PlayerBoard> board = gameModel.getCurrentPlayer()->getBoard();
+    int sourceSlot = move.getSource();
+
+    uint64_t key = Zobrist::factory(sourceSlot, *getSource(sourceSlot));
+
+    // Leftovers from a factory land in the dump centre
+    if (sourceSlot < CENTRE_SLOT_OFFSET) {
+        int centreSlot = CENTRE_SLOT_OFFSET + move.getDumpCentre();
+        key ^= Zobrist::factory(centreSlot, *getSource(centreSlot));
+    }
+
+    // The floor line is always included, as it takes any overflow
+    if (move.getDestination() != MOVE_FLOOR_LINE) {
+        key ^= Zobrist::patternLine(playerIndex, move.getDestination(),
+                                    *board->getPatternLine(move.getDestination()));
+    }
+
+    key ^= Zobrist::floorLine(playerIndex, *board->getFloorLine());
+    key ^= Zobrist::lid(*gameModel.getBoxLid());
+
+    return key;
+}
+
+uint64_t GameRules::playerKey(int playerIndex) {
+    shared_ptr<Player> player = gameModel.getAllPlayers()[playerIndex];
+    shared_ptr<PlayerBoard> board = player->getBoard();
+    uint64_t key = 0;
+
+    for (int row = 0; row != 5; ++row) {
+        key ^= Zobrist::patternLine(playerIndex, row, *board->getPatternLine(row));
+    }
+
+    key ^= Zobrist::floorLine(playerIndex, *board->getFloorLine());
+    key ^= Zobrist::wall(playerIndex, board->getMosaic().getWall());
+    key ^= Zobrist::score(playerIndex, player->getScore());
+
+    return key;
+}
@@ -0,0 +1,138 @@
+/*
+ * Game Rules
+ *
+ * The rules of the game, with no input or output of their own, so they can
+ * run without a terminal. Plays moves on a game model, and takes them back
+ * again. Each move records a small delta on an undo stack, so a search can
+ * walk down and back up the game tree on a single model. When a move ends the
+ * round, the position before scoring is also kept, which covers the scoring,
+ * the refill from the lid and the draws from the bag.
+ *
+ * Authors: C. Hodgen (s3031209), J. Osrecak (s3782455)
+ */
+
+#ifndef GAME_RULES_H
+#define GAME_RULES_H
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "GameModel.h"
+#include "GameState.h"
+#include "Move.h"
+
+// What a move led to
+enum MoveResult {
+    MOVE_PLAYED,
+    ROUND_OVER,
+    GAME_OVER
+};
+
+class GameRules {
+    public:
+        GameRules(GameModel& gameModel);
+
+        // Play a move for the current player, followed by the end of round
+        // scoring and refill, or the final scoring, when the move ends the
+        // round. The move must be legal.
+        MoveResult applyMove(Move move);
+
+        // True if a legal move would end the round by clearing the table
+        bool endsRound(Move move);
+
+        // Take back the last move applied, restoring the position exactly
+        void undoMove();
+
+        // Number of moves that can be taken back
+        unsigned int getHistorySize();
+
+        // Forget every move played so far
+        void clearHistory();
+
+        // Start a freshly built game: the first player moves first, and the
+        // factories are filled
+        void startGame();
+
+        // Fill the factories from the tile bag
+        void fillFactories();
+
+        // Refill the tile bag using tiles from the lid
+        void refillTileBag();
+
+        // Check if end of round condition has been met
+        bool endOfFactoryOffer();
+
+        // Calculate scores and move tiles, per the game rules
+        void doScoring();
+
+        // Calculate and apply scores to each player
+        void scorePlayer(std::shared_ptr<Player> player);
+
+        // Calculate the score for a player's pattern lines
+        int scorePlayerPatternLines(std::shared_ptr<Player> player);
+
+        // Calculate the score for a players' floor line
+        int scorePlayerFloorLine(std::shared_ptr<Player> player);
+
+        // Score a player would have if the round ended now, without changing
+        // the game
+        int getProjectedScore(int playerIndex);
+
+        // Points lost for a number of tiles on the floor line
+        static int getFloorPenalty(int numberOfTiles);
+
+        // Check if the end of game condition has been met
+        bool endOfGame();
+
+        // Calculate the scores for the end of a game
+        void doFinalScoring();
+
+        // Pass control to next player
+        void passTurnToNextPlayer();
+
+        // Index of the winning player once the game is over, or -1 for a draw.
+        // Players tied on score are split on rows completed.
+        int getWinner();
+
+    private:
+        // Everything needed to take back one move
+        struct MoveRecord {
+            uint64_t hash;
+            Move move;
+            uint8_t sourceCounts[NUMBER_OF_COLOURS];
+            uint8_t player;
+            uint8_t lineCount;
+            uint8_t floorCount;
+            uint8_t lidSize;
+            bool firstOnTable;
+            bool roundEnded;
+
+            // Colour of the tile the first player marker pushed off a full
+            // floor line, or NONE
+            uint8_t bumped;
+        };
+
+        GameModel& gameModel;
+
+        // Moves played, most recent last
+        std::vector<MoveRecord> history;
+
+        // Position before scoring, for each move that ended a round
+        std::vector<GameState> roundStates;
+
+        // Factory or centre in the given slot
+        std::shared_ptr<Factory> getSource(int slot);
+
+        // Pattern line or floor line a move places tiles on
+        std::shared_ptr<PatternLine> getDestination(std::shared_ptr<PlayerBoard> board, int destination);
+
+        // Zobrist key of every part of the position a move can change,
+        // other than the first player marker
+        uint64_t moveKey(Move move);
+
+        // Zobrist key of everything on a player's board, and their score
+        uint64_t playerKey(int playerIndex);
+};
+
+#endif // GAME_RULES_H
@@ -0,0 +1,512 @@
+#include <arpa/inet.h>
+#include <cerrno>
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <string>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/signalfd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+#include "GameServer.h"
+
+// Ids epoll reports the server's own descriptors with. Connections are
+// numbered after them.
+#define LISTENER_ID         0
+#define WAKE_ID             1
+#define SIGNALS_ID          2
+#define FIRST_CONNECTION_ID 3
+
+using std::make_shared;
+using std::shared_ptr;
+using std::string;
+using std::thread;
+using std::vector;
+
+GameServer::GameServer(unsigned int numberOfWorkers) :
+    nextConnection(FIRST_CONNECTION_ID),
+    epoll(-1),
+    listener(-1),
+    wake(-1),
+    signals(-1),
+    stopping(false)
+{
+    if (numberOfWorkers == 0) {
+        numberOfWorkers = thread::hardware_concurrency();
+    }
+    if (numberOfWorkers == 0) {
+        numberOfWorkers = 1;
+    }
+
+    for (unsigned int i = 0; i != numberOfWorkers; ++i) {
+        workers.push_back(make_shared<Worker>());
+    }
+}
+
+GameServer::~GameServer() {
+    shutdown();
+}
+
+void GameServer::setSeed(int seed) {
+    // Each worker counts up through its own share of the seeds
+    for (unsigned int i = 0; i != workers.size(); ++i) {
+        workers[i]->host.setSeed(seed + (int) i, (int) workers.size());
+    }
+}
+
+bool GameServer::listen(const string& address) {
+    bool valid = true;
+    string::size_type colon = address.rfind(':');
+
+    if (colon != string::npos && address.find('/') == string::npos) {
+        string host = address.substr(0, colon);
+        string port = address.substr(colon + 1);
+        char* end = nullptr;
+        long number = strtol(port.c_str(), &end, 10);
+        sockaddr_in local;
+
+        memset(&local, 0, sizeof(local));
+        local.sin_family = AF_INET;
+        local.sin_port = htons((uint16_t) number);
+
+        valid = !port.empty() && *end == '\0' && number >= 0 && number <= 65535 &&
+                inet_pton(AF_INET, host == "localhost" ? "127.0.0.1" : host.c_str(), &local.sin_addr) == 1;
+
+        if (valid) {
+            int on = 1;
+
+            listener = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+            valid = listener != -1 &&
+                    setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on)) == 0 &&
+                    bind(listener, (sockaddr*) &local, sizeof(local)) == 0;
+        }
+    } else {
+        sockaddr_un local;
+        struct stat info;
+
+        memset(&local, 0, sizeof(local));
+        local.sun_family = AF_UNIX;
+        valid = !address.empty() && address.size() < sizeof(local.sun_path);
+
+        if (valid) {
+            memcpy(local.sun_path, address.c_str(), address.size());
+
+            // A socket left behind by a server that did not stop cleanly
+            // would stop the bind, but anything else at the path is kept
+            if (stat(address.c_str(), &info) == 0 && S_ISSOCK(info.st_mode)) {
+                unlink(address.c_str());
+            }
+
+            listener = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+            valid = listener != -1 && bind(listener, (sockaddr*) &local, sizeof(local)) == 0;
+
+            if (valid) {
+                socketPath = address;
+            }
+        }
+    }
+
+    valid = valid && ::listen(listener, SERVER_BACKLOG) == 0;
+
+    if (!valid && listener != -1) {
+        close(listener);
+        listener = -1;
+    }
+
+    return valid;
+}
+
+void GameServer::run() {
+    // Block the signals before the workers start, so that only the
+    // signalfd hears them
+    sigset_t mask;
+    sigemptyset(&mask);
+    sigaddset(&mask, SIGINT);
+    sigaddset(&mask, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &mask, nullptr);
+
+    signals = signalfd(-1, &mask, SFD_NONBLOCK | SFD_CLOEXEC);
+    wake = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    epoll = epoll_create1(EPOLL_CLOEXEC);
+
+    int descriptors[] = { listener, wake, signals };
+    uint64_t ids[] = { LISTENER_ID, WAKE_ID, SIGNALS_ID };
+
+    for (unsigned int i = 0; i != 3; ++i) {
+        epoll_event event;
+        event.events = EPOLLIN;
+        event.data.u64 = ids[i];
+        epoll_ctl(epoll, EPOLL_CTL_ADD, descriptors[i], &event);
+    }
+
+    for (shared_ptr<Worker>& worker : workers) {
+        worker->thread = thread(&GameServer::work, this, std::ref(*worker));
+    }
+
+    epoll_event events[SERVER_MAX_EVENTS];
+
+    while (!stopping) {
+        int numberOfEvents = epoll_wait(epoll, events, SERVER_MAX_EVENTS, -1);
+
+        if (numberOfEvents < 0 && errno != EINTR) {
+            stopping = true;
+        }
+
+        for (int i = 0; i < numberOfEvents; ++i) {
+            uint64_t id = events[i].data.u64;
+
+            if (id == LISTENER_ID) {
+                acceptConnections();
+            } else if (id == WAKE_ID) {
+                deliverReplies();
+            } else if (id == SIGNALS_ID) {
+                stopping = true;
+            } else {
+                auto found = connections.find(id);
+
+                if (found != connections.end()) {
+                    Connection& connection = found->second;
+                    bool open = true;
+
+                    if (events[i].events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR)) {
+                        open = readConnection(id, connection);
+                    }
+                    if (open && (events[i].events & EPOLLOUT)) {
+                        open = writeConnection(id, connection);
+                    }
+
+                    if (!open || isDone(connection)) {
+                        closeConnection(id);
+                    }
+                }
+            }
+        }
+    }
+
+    shutdown();
+}
+
+void GameServer::work(Worker& worker) {
+    bool running = true;
+
+    while (running) {
+        Job job;
+        bool haveJob = false;
+
+        {
+            std::unique_lock<std::mutex> guard(worker.lock);
+            worker.ready.wait(guard, [&] { return stopping || !worker.jobs.empty(); });
+
+            // Commands already taken are still answered when stopping
+            if (!worker.jobs.empty()) {
+                job = std::move(worker.jobs.front());
+                worker.jobs.pop_front();
+                haveJob = true;
+            } else {
+                running = false;
+            }
+        }
+
+        if (haveJob && job.gather) {
+            gather(worker, job);
+        } else if (haveJob) {
+            string output;
+
+            worker.host.handle(job.line, output);
+            postReply(job.connection, output);
+        }
+    }
+}
+
+void GameServer::gather(Worker& worker, Job& job) {
+    Gather& gather = *job.gather;
+    std::lock_guard<std::mutex> guard(gather.lock);
+
+    if (gather.command == "games") {
+        worker.host.listGames(gather.rows);
+    } else {
+        gather.numberOfGames += worker.host.getNumberOfGames();
+        gather.bytes += worker.host.getMemoryUsage();
+    }
+
+    --gather.remaining;
+    if (gather.remaining == 0) {
+        string output = gather.command == "games" ? GameHost::getGameList(gather.rows) :
+                        GameHost::getMemoryReport(gather.numberOfGames, gather.bytes);
+
+        output += HOST_OK + "\n";
+        postReply(job.connection, output);
+    }
+}
+
+void GameServer::postReply(uint64_t connection, string& text) {
+    {
+        std::lock_guard<std::mutex> guard(repliesLock);
+        replies.push_back(Reply());
+        replies.back().connection = connection;
+        replies.back().text.swap(text);
+    }
+
+    uint64_t one = 1;
+    if (write(wake, &one, sizeof(one)) != sizeof(one)) {
+        // The counter is already waiting to be read, so the epoll thread
+        // will still look at the replies
+    }
+}
+
+void GameServer::acceptConnections() {
+    bool accepting = true;
+
+    while (accepting) {
+        int socket = accept4(listener, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+
+        if (socket == -1) {
+            // Otherwise there are none left, or there is no room for more
+            // until some close
+            accepting = errno == EINTR || errno == ECONNABORTED;
+        } else {
+            uint64_t id = nextConnection;
+            ++nextConnection;
+
+            if (socketPath.empty()) {
+                // Each reply is written whole, so there is nothing to gain
+                // from holding back small writes
+                int on = 1;
+                setsockopt(socket, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+            }
+
+            Connection& connection = connections[id];
+            connection.socket = socket;
+            connection.pending = 0;
+            connection.finished = false;
+            connection.writing = false;
+
+            epoll_event event;
+            event.events = EPOLLIN | EPOLLRDHUP;
+            event.data.u64 = id;
+            epoll_ctl(epoll, EPOLL_CTL_ADD, socket, &event);
+        }
+    }
+}
+
+bool GameServer::readConnection(uint64_t id, Connection& connection) {
+    bool open = true;
+    bool reading = !connection.finished;
+    char buffer[SERVER_READ_SIZE];
+
+    while (reading) {
+        ssize_t received = recv(connection.socket, buffer, sizeof(buffer), 0);
+
+        if (received > 0) {
+            connection.input.append(buffer, received);
+        } else if (received == 0) {
+            connection.finished = true;
+            reading = false;
+        } else if (errno != EINTR) {
+            open = errno == EAGAIN || errno == EWOULDBLOCK;
+            reading = false;
+        }
+    }
+
+    // A last command may come without a newline
+    if (connection.finished && !connection.input.empty()) {
+        connection.input += '\n';
+    }
+
+    string::size_type start = 0;
+    string::size_type end = connection.input.find('\n');
+
+    while (end != string::npos) {
+        string line = connection.input.substr(start, end - start);
+
+        if (line.find_first_not_of(" \r") != string::npos) {
+            ++connection.pending;
+            dispatch(id, line);
+        }
+
+        start = end + 1;
+        end = connection.input.find('\n', start);
+    }
+
+    connection.input.erase(0, start);
+
+    if (connection.input.size() > SERVER_MAX_LINE) {
+        open = false;
+    } else if (open && connection.finished) {
+        // Stop listening for input, which would otherwise be reported
+        // again and again
+        updateEvents(id, connection);
+    }
+
+    return open;
+}
+
+void GameServer::dispatch(uint64_t id, const string& line) {
+    string::size_type start = line.find_first_not_of(' ');
+    string::size_type end = line.find_last_not_of(" \r");
+    string::size_type split = line.find(' ', start);
+    bool hostCommand = split == string::npos || split > end;
+    unsigned int first = 0;
+    unsigned int last = 1;
+    Job job;
+
+    job.connection = id;
+    job.line = line;
+
+    if (hostCommand) {
+        string command = line.substr(start, end + 1 - start);
+
+        // Every worker has a share of the games to report on. Any worker
+        // can turn away other lines without a game id.
+        if (command == "games" || command == "memory") {
+            job.gather = make_shared<Gather>();
+            job.gather->command = command;
+            job.gather->remaining = workers.size();
+            job.gather->numberOfGames = 0;
+            job.gather->bytes = 0;
+            last = workers.size();
+        }
+    } else {
+        first = std::hash<string>()(line.substr(start, split - start)) % workers.size();
+        last = first + 1;
+    }
+
+    for (unsigned int i = first; i != last; ++i) {
+        Worker& worker = *workers[i];
+
+        {
+            std::lock_guard<std::mutex> guard(worker.lock);
+            worker.jobs.push_back(job);
+        }
+
+        worker.ready.notify_one();
+    }
+}
+
+bool GameServer::writeConnection(uint64_t id, Connection& connection) {
+    bool open = true;
+    bool blocked = false;
+    size_t written = 0;
+
+    while (open && !blocked && written < connection.output.size()) {
+        ssize_t sent = send(connection.socket, connection.output.data() + written,
+                            connection.output.size() - written, MSG_NOSIGNAL);
+
+        if (sent >= 0) {
+            written += sent;
+        } else if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            blocked = true;
+        } else if (errno != EINTR) {
+            open = false;
+        }
+    }
+
+    connection.output.erase(0, written);
+
+    // Only wait for the socket to take more while there is more to write
+    if (open && connection.writing != !connection.output.empty()) {
+        connection.writing = !connection.output.empty();
+        updateEvents(id, connection);
+    }
+
+    return open;
+}
+
+void GameServer::deliverReplies() {
+    uint64_t count = 0;
+    vector<Reply> ready;
+
+    if (read(wake, &count, sizeof(count)) != sizeof(count)) {
+        // Already read along with an earlier wake up
+    }
+
+    {
+        std::lock_guard<std::mutex> guard(repliesLock);
+        ready.swap(replies);
+    }
+
+    for (Reply& reply : ready) {
+        auto found = connections.find(reply.connection);
+
+        // Replies for connections that have closed are dropped
+        if (found != connections.end()) {
+            Connection& connection = found->second;
+
+            connection.output += reply.text;
+            --connection.pending;
+
+            if (!writeConnection(reply.connection, connection) || isDone(connection)) {
+                closeConnection(reply.connection);
+            }
+        }
+    }
+}
+
+void GameServer::updateEvents(uint64_t id, Connection& connection) {
+    epoll_event event;
+    event.events = (connection.finished ? 0 : EPOLLIN | EPOLLRDHUP) | (connection.writing ? EPOLLOUT : 0);
+    event.data.u64 = id;
+    epoll_ctl(epoll, EPOLL_CTL_MOD, connection.socket, &event);
+}
+
+bool GameServer::isDone(Connection& connection) {
+    return connection.finished && connection.pending == 0 && connection.output.empty();
+}
+
+void GameServer::closeConnection(uint64_t id) {
+    auto found = connections.find(id);
+
+    if (found != connections.end()) {
+        epoll_ctl(epoll, EPOLL_CTL_DEL, found->second.socket, nullptr);
+        close(found->second.socket);
+        connections.erase(found);
+    }
+}
+
+void GameServer::shutdown() {
+    stopping = true;
+
+    for (shared_ptr<Worker>& worker : workers) {
+        // Taking the lock makes sure a worker about to wait sees the flag
+        {
+            std::lock_guard<std::mutex> guard(worker->lock);
+        }
+
+        worker->ready.notify_all();
+
+        if (worker->thread.joinable()) {
+            worker->thread.join();
+        }
+    }
+
+    for (auto& connection : connections) {
+        close(connection.second.socket);
+    }
+    connections.clear();
+
+    int descriptors[] = { epoll, listener, wake, signals };
+    for (int descriptor : descriptors) {
+        if (descriptor != -1) {
+            close(descriptor);
+        }
+    }
+
+    epoll = -1;
+    listener = -1;
+    wake = -1;
+    signals = -1;
+
+    if (!socketPath.empty()) {
+        unlink(socketPath.c_str());
+        socketPath.clear();
+    }
+}
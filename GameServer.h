@@ -0,0 +1,176 @@
+/*
+ * Game Server
+ *
+ * Serves games to many clients at once, over a unix socket or TCP, with
+ * the same line commands as "--host". One thread waits on every connection
+ * with epoll and splits what arrives into lines. The games are shared out
+ * between a small pool of workers by a hash of their id, and each worker
+ * keeps its games in its own GameHost, so a game is only ever touched by
+ * one worker, in the order its commands arrived, and only the queues
+ * between the threads are locked. Replies go back to the epoll thread,
+ * which adds each one whole to its connection's output.
+ *
+ * Authors: C. Hodgen (s3031209), J. Osrecak (s3782455)
+ */
+
+#ifndef GAME_SERVER_H
+#define GAME_SERVER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "GameHost.h"
+
+// Events taken from epoll at once
+#define SERVER_MAX_EVENTS   64
+
+// Bytes read from a connection at once
+#define SERVER_READ_SIZE    4096
+
+// Longest command accepted, after which the connection is closed
+#define SERVER_MAX_LINE     4096
+
+// Connections waiting to be accepted
+#define SERVER_BACKLOG      128
+
+class GameServer {
+    public:
+        // Share the games between a number of workers, 0 for one per core
+        GameServer(unsigned int numberOfWorkers);
+        ~GameServer();
+
+        // Seed the games from this seed instead of at random
+        void setSeed(int seed);
+
+        // Listen on "host:port" for TCP, where host is "localhost" or an
+        // IPv4 address, or otherwise on a unix socket at the path given.
+        // Returns false if the address can't be used.
+        bool listen(const std::string& address);
+
+        // Serve clients until interrupted or terminated
+        void run();
+
+    private:
+        // Replies for the host's own commands, put together from every
+        // worker's share of the games
+        struct Gather {
+            std::mutex lock;
+            std::string command;
+            unsigned int remaining;
+            unsigned int numberOfGames;
+            size_t bytes;
+            std::vector<std::string> rows;
+        };
+
+        // A command for a worker, from a connection
+        struct Job {
+            uint64_t connection;
+            std::string line;
+
+            // Set for the host's own commands, which every worker answers
+            std::shared_ptr<Gather> gather;
+        };
+
+        struct Reply {
+            uint64_t connection;
+            std::string text;
+        };
+
+        struct Worker {
+            GameHost host;
+            std::thread thread;
+            std::mutex lock;
+            std::condition_variable ready;
+            std::deque<Job> jobs;
+        };
+
+        struct Connection {
+            int socket;
+
+            // Bytes read but not yet a whole line, and bytes still to write
+            std::string input;
+            std::string output;
+
+            // Commands passed on and not yet answered
+            unsigned int pending;
+
+            // True once the client has finished sending. The connection
+            // closes when every command has been answered and written.
+            bool finished;
+
+            // True while epoll is also waiting for the socket to take output
+            bool writing;
+        };
+
+        std::vector<std::shared_ptr<Worker>> workers;
+
+        // Open connections, by the id epoll reports them with
+        std::unordered_map<uint64_t, Connection> connections;
+        uint64_t nextConnection;
+
+        int epoll;
+        int listener;
+
+        // Woken by the workers when there are replies
+        int wake;
+
+        // Reports interrupt and terminate
+        int signals;
+
+        // Unix socket to remove when the server stops, or empty
+        std::string socketPath;
+
+        // Replies waiting for the epoll thread
+        std::mutex repliesLock;
+        std::vector<Reply> replies;
+
+        std::atomic<bool> stopping;
+
+        // Take commands for one worker until the server stops
+        void work(Worker& worker);
+
+        // Answer a worker's share of one of the host's own commands, and
+        // reply once every worker has
+        void gather(Worker& worker, Job& job);
+
+        // Pass a reply to the epoll thread
+        void postReply(uint64_t connection, std::string& text);
+
+        // Take every waiting connection
+        void acceptConnections();
+
+        // Read what a connection has sent, and pass on each whole line.
+        // Returns false once the connection should be closed.
+        bool readConnection(uint64_t id, Connection& connection);
+
+        // Send a command to the worker for its game, or to every worker
+        void dispatch(uint64_t id, const std::string& line);
+
+        // Write as much output as the socket will take. Returns false once
+        // the connection should be closed.
+        bool writeConnection(uint64_t id, Connection& connection);
+
+        // Add the workers' replies to their connections
+        void deliverReplies();
+
+        // Tell epoll which events a connection is waiting for
+        void updateEvents(uint64_t id, Connection& connection);
+
+        // True once a connection has nothing left to do
+        bool isDone(Connection& connection);
+
+        void closeConnection(uint64_t id);
+
+        // Stop the workers and close every socket
+        void shutdown();
+};
+
+#endif // GAME_SERVER_H
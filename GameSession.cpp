@@ -0,0 +1,213 @@
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "GameRules.h"
+#include "GameSession.h"
+#include "ModelBuilder.h"
+#include "MoveGenerator.h"
+
+using std::make_shared;
+using std::shared_ptr;
+using std::string;
+using std::vector;
+
+GameSession::GameSession() :
+    gameModel(make_shared<GameModel>()),
+    seed(0),
+    inProgress(false)
+{}
+
+bool GameSession::newGame(int numberOfCentres, vector<string>& playerNames, int seed, string& output) {
+    bool valid = numberOfCentres >= 1 && numberOfCentres <= MAX_STATE_CENTRES &&
+                 playerNames.size() >= 2 && playerNames.size() <= MAX_STATE_PLAYERS;
+
+    if (!valid) {
+        output += "Error: A game needs 1-2 centres and 2-4 players.\n";
+    } else {
+        gameModel = make_shared<GameModel>();
+        this->seed = seed;
+        valid = ModelBuilder(*gameModel).createNewGame(numberOfCentres, playerNames.data(), playerNames.size(), seed);
+        inProgress = valid;
+
+        if (!valid) {
+            output += "Error: Game is defective.\n";
+        } else {
+            GameRules(*gameModel).startGame();
+
+            output += "Game successfully created.\n";
+            seatBots(output);
+            playBotTurns(output);
+
+            if (inProgress) {
+                output += gameModel->getPrintable();
+            }
+        }
+    }
+
+    return valid;
+}
+
+bool GameSession::loadGame(const string& fileName, int seed, string& output) {
+    shared_ptr<GameModel> loaded = make_shared<GameModel>();
+    bool valid = ModelBuilder(*loaded).loadSaveFile(fileName);
+
+    if (!valid) {
+        output += "Error: Save game is defective.\n";
+    } else {
+        gameModel = loaded;
+        this->seed = seed;
+
+        output += "Game successfully loaded.\n";
+        inProgress = true;
+        seatBots(output);
+        playBotTurns(output);
+
+        if (inProgress) {
+            output += gameModel->getPrintable();
+        }
+    }
+
+    return valid;
+}
+
+bool GameSession::handle(const string& command, string& output) {
+    bool valid = true;
+    bool dumpGiven = false;
+    Move move = Move::parse(command, dumpGiven);
+    string keyword = command.substr(0, 4);
+
+    if (move.isValid()) {
+        if (!inProgress) {
+            output += "Error: The game is over.\n";
+            valid = false;
+        } else if (!MoveGenerator(*gameModel).isLegal(move)) {
+            output += "Error: That move can't be played.\n";
+            valid = false;
+        } else if (!dumpGiven && move.getSource() < CENTRE_SLOT_OFFSET &&
+                   gameModel->getNumberOfCentreFactories() == 2) {
+            // There is no one to ask, so the centre has to come with the move
+            output += "Error: Say which centre takes the leftover tiles, C or D.\n";
+            valid = false;
+        } else {
+            playMove(move, output);
+            playBotTurns(output);
+
+            if (inProgress) {
+                output += gameModel->getPrintable();
+            }
+        }
+    } else if ((keyword == "show" || keyword == "SHOW" || keyword == "Show") &&
+               command.size() > 5 && command[4] == ' ') {
+        string playerName = command.substr(5);
+        int playerIndex = -1;
+
+        for (int i = 0; i != gameModel->getNumberOfPlayers(); ++i) {
+            if (gameModel->getAllPlayers()[i]->getName() == playerName) {
+                playerIndex = i;
+            }
+        }
+
+        if (playerIndex == -1) {
+            output += "Error: No player called " + playerName + ".\n";
+            valid = false;
+        } else {
+            shared_ptr<Player> player = gameModel->getAllPlayers()[playerIndex];
+            output += "Name: " + player->getName() + "\n" + player->getBoard()->getPrintable() + "\n\n";
+        }
+    } else if (command == "s" || command == "save") {
+        output += gameModel->toString();
+    } else if (command == "state") {
+        output += gameModel->getPrintable();
+    } else if (command == "h" || command == "help" || command == "?") {
+        output += getCommands();
+    } else {
+        output += "Invalid option.\n";
+        valid = false;
+    }
+
+    return valid;
+}
+
+bool GameSession::isInProgress() {
+    return inProgress;
+}
+
+GameModel& GameSession::getGameModel() {
+    return *gameModel;
+}
+
+size_t GameSession::getMemoryUsage() {
+    return sizeof(GameSession) + SHARED_BLOCK_SIZE + gameModel->getMemoryUsage() +
+           bots.capacity() * sizeof(shared_ptr<Policy>);
+}
+
+void GameSession::playMove(Move move, string& output) {
+    GameRules rules(*gameModel);
+    MoveResult result = rules.applyMove(move);
+
+    if (!gameModel->isConserved()) {
+        output += "Error: Game is defective.\n";
+        inProgress = false;
+    } else if (result == GAME_OVER) {
+        int winner = rules.getWinner();
+
+        if (winner == -1) {
+            output += "It's a draw!\n";
+        } else {
+            output += gameModel->getAllPlayers()[winner]->getName() + " is the winner!\n";
+        }
+
+        inProgress = false;
+    }
+}
+
+void GameSession::playBotTurns(string& output) {
+    Move moves[MAX_MOVES];
+
+    while (inProgress && bots[gameModel->getCurrentPlayerIndex()]) {
+        shared_ptr<Player> player = gameModel->getCurrentPlayer();
+        unsigned int numberOfMoves = MoveGenerator(*gameModel).generate(moves);
+
+        if (numberOfMoves == 0) {
+            // Only possible once every tile is stuck on the boards
+            output += player->getName() + " has no move to make.\n";
+            inProgress = false;
+        } else {
+            Move move = bots[gameModel->getCurrentPlayerIndex()]->chooseMove(*gameModel, moves, numberOfMoves);
+            bool showCentre = move.getSource() < CENTRE_SLOT_OFFSET && gameModel->getNumberOfCentreFactories() == 2;
+
+            output += player->getName() + " plays " + move.toString(showCentre) + "\n";
+            playMove(move, output);
+        }
+    }
+}
+
+void GameSession::seatBots(string& output) {
+    bots.clear();
+
+    for (int i = 0; i != gameModel->getNumberOfPlayers(); ++i) {
+        string& name = gameModel->getAllPlayers()[i]->getName();
+        shared_ptr<Policy> bot = nullptr;
+
+        if (name.compare(0, BOT_NAME_PREFIX.size(), BOT_NAME_PREFIX) == 0) {
+            bot = Policy::create(name.substr(BOT_NAME_PREFIX.size()), seed + i);
+            if (!bot) {
+                output += "Warning: no bot called " + name + ", they will play as a person.\n";
+            }
+        }
+
+        bots.push_back(bot);
+    }
+}
+
+string GameSession::getCommands() {
+    string commands = "Commands:\n";
+    commands += "Show a player's board -> show <playerName>\n";
+    commands += "To make a turn -> <source> <Tile> <destination> [<centre>]\n";
+    commands += "To see the table -> state\n";
+    commands += "To get the save game -> save\n";
+    commands += "To get the commands list -> help\n";
+
+    return commands;
+}
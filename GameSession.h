@@ -0,0 +1,73 @@
+/*
+ * Game Session
+ *
+ * One game held by a game host. Commands are given a line at a time, in
+ * the same form typed in the game ("2 y 5", "show NAME", "save"), and each
+ * one is answered with text rather than printed, so a session never reads
+ * or writes a stream. Players named BOT_NAME_PREFIX and a policy take their
+ * turns straight after the move before them.
+ *
+ * Authors: C. Hodgen (s3031209), J. Osrecak (s3782455)
+ */
+
+#ifndef GAME_SESSION_H
+#define GAME_SESSION_H
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "GameModel.h"
+#include "Move.h"
+#include "Policy.h"
+
+class GameSession {
+    public:
+        GameSession();
+
+        // Start a new game. The bots are seeded from the game's seed.
+        // Returns false, with the reason in output, if the game can't be made.
+        bool newGame(int numberOfCentres, std::vector<std::string>& playerNames, int seed, std::string& output);
+
+        // Load a saved game, compact or text. Returns false, with the reason
+        // in output, if it cannot be read or is defective.
+        bool loadGame(const std::string& fileName, int seed, std::string& output);
+
+        // Run a command: a turn, "show NAME", "save" for the save text,
+        // "state" or "help". The reply is added to output. Returns false if
+        // the command is not known or not allowed.
+        bool handle(const std::string& command, std::string& output);
+
+        // False once the game is over or has stopped
+        bool isInProgress();
+
+        GameModel& getGameModel();
+
+        // Estimated bytes held by the session and its game, not counting
+        // the bots
+        size_t getMemoryUsage();
+
+    private:
+        std::shared_ptr<GameModel> gameModel;
+
+        // Players seated by a bot policy, by index, or nullptr for a person
+        std::vector<std::shared_ptr<Policy>> bots;
+
+        int seed;
+        bool inProgress;
+
+        // Play a move for the current player, and report the end of the game
+        void playMove(Move move, std::string& output);
+
+        // Let the bots take their turns, until it is a person's turn or the
+        // game is over
+        void playBotTurns(std::string& output);
+
+        // Give a bot to each player named BOT_NAME_PREFIX and a policy
+        void seatBots(std::string& output);
+
+        // Help for the commands a session takes
+        std::string getCommands();
+};
+
+#endif // GAME_SESSION_H
@@ -0,0 +1,44 @@
+#include <type_traits>
+
+#include "GameState.h"
+
+// The whole point of a GameState is that it can be copied as raw bytes
+static_assert(std::is_trivially_copyable<GameState>::value,
+              "GameState must be trivially copyable");
+static_assert(sizeof(GameState) <= 256, "GameState must fit in 256 bytes");
+
+TileColour PackedTiles::get(unsigned int index) const {
+    unsigned int bit = index * 3;
+    unsigned int bits = data[bit / 8];
+
+    // A tile may straddle two bytes
+    if (bit / 8 + 1 < PACKED_TILE_BYTES) {
+        bits |= data[bit / 8 + 1] << 8;
+    }
+
+    return (TileColour) ((bits >> (bit % 8)) & 0x7);
+}
+
+void PackedTiles::set(unsigned int index, TileColour colour) {
+    unsigned int bit = index * 3;
+    unsigned int mask = 0x7u << (bit % 8);
+    unsigned int bits = ((unsigned int) colour << (bit % 8)) & mask;
+
+    data[bit / 8] = (data[bit / 8] & ~mask) | bits;
+
+    if (bit / 8 + 1 < PACKED_TILE_BYTES) {
+        data[bit / 8 + 1] = (data[bit / 8 + 1] & ~(mask >> 8)) | (bits >> 8);
+    }
+}
+
+unsigned int GameState::getFactoryCount(unsigned int factory, TileColour colour) const {
+    return (factories[factory] >> (colour * 3)) & 0x7;
+}
+
+void GameState::setFactoryCount(unsigned int factory, TileColour colour, unsigned int count) {
+    if (count > 0x7) {
+        count = 0x7;
+    }
+
+    factories[factory] = (factories[factory] & ~(0x7 << (colour * 3))) | (count << (colour * 3));
+}
@@ -0,0 +1,85 @@
+/*
+ * Game State
+ * 
+ * Flat, fixed size snapshot of everything in a GameModel except the player
+ * names. A GameState holds no pointers, so it can be copied with memcpy and
+ * kept in large numbers for analysis. Use GameModel::saveState to take a
+ * snapshot and ModelBuilder::loadState to turn one back into a model.
+ * 
+ * Authors: C. Hodgen (s3031209), J. Osrecak (s3782455)
+ */
+
+#ifndef GAME_STATE_H
+#define GAME_STATE_H
+
+#include <cstdint>
+
+#include "PatternLine.h"
+#include "TileQueue.h"
+#include "Types.h"
+
+#define MAX_STATE_PLAYERS   4
+#define MAX_STATE_FACTORIES 9
+#define MAX_STATE_CENTRES   2
+
+// Number of bytes needed to hold every tile at 3 bits per tile
+#define PACKED_TILE_BYTES   ((TILE_QUEUE_CAPACITY * 3 + 7) / 8)
+
+// An ordered list of up to 100 tiles, packed at 3 bits per tile
+struct PackedTiles {
+    uint8_t data[PACKED_TILE_BYTES];
+    uint8_t length;
+
+    // Get the colour at index
+    TileColour get(unsigned int index) const;
+
+    // Set the colour at index
+    void set(unsigned int index, TileColour colour);
+};
+
+// Everything owned by a single player, other than their name
+struct PlayerState {
+    // Occupancy mask of the wall, as used by Mosaic
+    uint32_t wall;
+
+    int16_t score;
+
+    // Number of tiles in each pattern line
+    uint8_t lineCount[5];
+
+    // Colour of each pattern line, NONE if empty
+    uint8_t lineColour[5];
+
+    // Floor line tiles in the order they were placed
+    uint8_t floorCount;
+    uint8_t floor[MAX_LINE_SIZE];
+};
+
+struct GameState {
+    uint8_t numberOfPlayers;
+    uint8_t numberOfFactories;
+    uint8_t numberOfCentres;
+    uint8_t currentPlayer;
+
+    // True while the first player marker sits on the table
+    uint8_t firstOnTable;
+
+    // Colour counts of each factory, 3 bits per colour
+    uint16_t factories[MAX_STATE_FACTORIES];
+
+    // Colour counts of each table centre
+    uint8_t centres[MAX_STATE_CENTRES][NUMBER_OF_COLOURS];
+
+    PackedTiles bag;
+    PackedTiles lid;
+
+    PlayerState players[MAX_STATE_PLAYERS];
+
+    // Get the count of a colour in a factory
+    unsigned int getFactoryCount(unsigned int factory, TileColour colour) const;
+
+    // Set the count of a colour in a factory
+    void setFactoryCount(unsigned int factory, TileColour colour, unsigned int count);
+};
+
+#endif // GAME_STATE_H
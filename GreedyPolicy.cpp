@@ -0,0 +1,25 @@
+#include "GameRules.h"
+#include "GreedyPolicy.h"
+
+GreedyPolicy::GreedyPolicy() {}
+
+Move GreedyPolicy::chooseMove(GameModel& gameModel, Move* moves, unsigned int numberOfMoves) {
+    GameRules rules(gameModel);
+    int playerIndex = gameModel.getCurrentPlayerIndex();
+    Move best = moves[0];
+    int bestScore = -1;
+
+    // Try each move on the model and take it back again
+    for (unsigned int i = 0; i != numberOfMoves; ++i) {
+        rules.applyMove(moves[i]);
+        int score = rules.getProjectedScore(playerIndex);
+        rules.undoMove();
+
+        if (score > bestScore) {
+            best = moves[i];
+            bestScore = score;
+        }
+    }
+
+    return best;
+}
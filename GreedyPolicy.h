@@ -0,0 +1,23 @@
+/*
+ * Greedy Policy
+ * 
+ * Picks the move that leaves the player with the best score if the round
+ * were to end straight after it. Ties go to the first such move, so the
+ * policy is deterministic.
+ * 
+ * Authors: C. Hodgen (s3031209), J. Osrecak (s3782455)
+ */
+
+#ifndef GREEDY_POLICY_H
+#define GREEDY_POLICY_H
+
+#include "Policy.h"
+
+class GreedyPolicy : public Policy {
+    public:
+        GreedyPolicy();
+
+        Move chooseMove(GameModel& gameModel, Move* moves, unsigned int numberOfMoves);
+};
+
+#endif // GREEDY_POLICY_H
@@ -1,18 +1,14 @@
 
-#include <fstream>
+#include <cerrno>
 #include <iostream>
 #include <string>
-
-#define COMMENT_MARKER      '#'
-#define KEY_VALUE_DELIMITER '='
+#include <unistd.h>
 
 #include "IOHandler.h"
 
 using std::cin;
 using std::cout;
 using std::endl;
-using std::map;
-using std::ofstream;
 using std::string;
 
 IOHandler::IOHandler() :
@@ -25,37 +21,6 @@ bool IOHandler::readFromStdIn(string& input) {
     return readFromStream(input, cin);
 }
 
-bool IOHandler::loadGameFile(map<string, string>& rawData, const string& fileName) {
-    std::ifstream inputFile(fileName);
-    string line = "";
-    
-    bool success = false;
-
-    if(inputFile) {
-        while(readFromStream(line, inputFile)) {
-            if(!line.empty()) {
-                if (line.at(0) != COMMENT_MARKER) {
-                    addDataTuple(rawData, line);
-                }
-            }
-        }
-        
-        inputFile.close();
-    }
-    
-    return success;
-}
-
-void IOHandler::addDataTuple(map<string, string>& rawData, const string& line) {
-    // Stored in the file as: SOME_KEY=SOME_VALUE
-    string key = line.substr(0, line.find(KEY_VALUE_DELIMITER));
-    string value = line.substr(key.length() + 1);
-
-    if (!key.empty()) {
-        rawData[key] = value;
-    }
-}
-
 bool IOHandler::readFromStream(std::string& input, std::istream& stream) {
     bool success = false;
     wasEof = false;
@@ -76,15 +41,30 @@ void IOHandler::printToStdOut(string output) {
     cout << output;
 }
 
-void IOHandler::printToFile(string output, string fileName) {
-    ofstream outputFile(fileName);
+void IOHandler::printToStdOut(OutputFrame& frame) {
+    const char* data = frame.getData();
+    size_t size = frame.getSize();
+    bool writing = true;
+
+    // Earlier output through cout has to come out first
+    cout.flush();
 
-    if (outputFile.is_open()) {
-        outputFile << output;
-        outputFile.close();
-    } else {
-        // something went wrong
+    while (writing && size != 0) {
+        ssize_t written = write(STDOUT_FILENO, data, size);
+
+        if (written > 0) {
+            data += written;
+            size -= written;
+        } else {
+            writing = written < 0 && errno == EINTR;
+        }
     }
+
+    frame.clear();
+}
+
+bool IOHandler::isTerminal() {
+    return isatty(STDOUT_FILENO) == 1;
 }
 
 bool IOHandler::eof() {
@@ -8,9 +8,11 @@
 #ifndef IO_HANDLER_H
 #define IO_HANDLER_H
 
-#include <map>
+#include <istream>
 #include <string>
 
+#include "OutputFrame.h"
+
 class IOHandler {
     public:
         IOHandler();
@@ -21,15 +23,15 @@ class IOHandler {
 
         int readIntFromStdIn();
 
-        // Load game file into data map
-        bool loadGameFile(std::map<std::string, std::string>& rawData,
-                          const std::string& fileName);
-        
         // Print string to stdout
         void printToStdOut(const std::string output);
 
-        // Print a string to a file, overwriting it if it exists
-        void printToFile(const std::string output, const std::string fileName);
+        // Print a whole screen to stdout in one write, after anything
+        // already printed, then empty the frame
+        void printToStdOut(OutputFrame& frame);
+
+        // True if stdout is a terminal, so can show colours
+        bool isTerminal();
 
         // Check for eof
         bool eof();
@@ -40,10 +42,6 @@ class IOHandler {
 
         // Receive a line from an input stream
         bool readFromStream(std::string& input, std::istream& stream);
-
-        // Parse and add key/value tuple to game data while loading
-        void addDataTuple(std::map<std::string, std::string>& rawData,
-                          const std::string& line);
 };
 
 #endif // IO_HANDLER_H
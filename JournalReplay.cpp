@@ -0,0 +1,165 @@
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "CompactSave.h"
+#include "GameRules.h"
+#include "JournalReplay.h"
+#include "MappedFile.h"
+#include "ModelBuilder.h"
+#include "MoveGenerator.h"
+#include "MoveJournal.h"
+
+using std::string;
+using std::vector;
+
+JournalReplay::JournalReplay() :
+    seeded(false),
+    seed(0),
+    numberOfCentres(0)
+{}
+
+bool JournalReplay::load(const string& fileName) {
+    MappedFile file(fileName);
+
+    return file.isOpen() && read(file.getData(), file.getSize());
+}
+
+bool JournalReplay::read(const uint8_t* journal, size_t size) {
+    bool valid = size >= JOURNAL_HEADER &&
+                 std::memcmp(journal, JOURNAL_MAGIC, 3) == 0 &&
+                 journal[3] == JOURNAL_VERSION;
+    size_t position = JOURNAL_HEADER;
+
+    data.assign(journal, journal + size);
+    moves.clear();
+    checkpoints.clear();
+    seeded = false;
+    names.clear();
+
+    // Stop at the end, or at a partial record
+    while (valid && position + 2 <= size) {
+        unsigned int word = data[position] | data[position + 1] << 8;
+        unsigned int tag = word & JOURNAL_TAG_MASK;
+        size_t length = word & JOURNAL_LENGTH_MASK;
+        bool first = position == JOURNAL_HEADER;
+
+        if (tag == JOURNAL_CHECKPOINT || tag == JOURNAL_SEED) {
+            if (position + 2 + length > size) {
+                position = size;
+            } else if (tag == JOURNAL_SEED) {
+                // Only the first record can start a game
+                valid = first && readSeed(data.data() + position + 2, length);
+                position += 2 + length;
+            } else {
+                checkpoints.push_back({ (unsigned int) moves.size(), position + 2, length });
+                position += 2 + length;
+            }
+        } else {
+            valid = !first;
+            moves.push_back(Move(word));
+            position += 2;
+        }
+    }
+
+    // Something to start from
+    valid = valid && (seeded || (!checkpoints.empty() && checkpoints[0].turn == 0));
+
+    return valid;
+}
+
+unsigned int JournalReplay::getNumberOfMoves() {
+    return moves.size();
+}
+
+Move JournalReplay::getMove(unsigned int index) {
+    return moves[index];
+}
+
+bool JournalReplay::hasSeed() {
+    return seeded;
+}
+
+int JournalReplay::getSeed() {
+    return seed;
+}
+
+bool JournalReplay::seek(unsigned int turn, GameModel& gameModel) {
+    bool valid = turn <= moves.size();
+
+    if (valid) {
+        // The start of a seeded game counts as a checkpoint before any
+        // moves, for when there is no later one
+        Checkpoint nearest = { 0, 0, 0 };
+        for (const Checkpoint& checkpoint : checkpoints) {
+            if (checkpoint.turn <= turn) {
+                nearest = checkpoint;
+            }
+        }
+
+        valid = restore(nearest, gameModel);
+
+        GameRules gameRules(gameModel);
+        MoveGenerator moveGenerator(gameModel);
+        MoveResult result = MOVE_PLAYED;
+
+        for (unsigned int i = nearest.turn; i != turn && valid; ++i) {
+            valid = result != GAME_OVER && moveGenerator.isLegal(moves[i]);
+
+            if (valid) {
+                result = gameRules.applyMove(moves[i]);
+            }
+        }
+
+        // Nothing needs taking back
+        gameRules.clearHistory();
+    }
+
+    return valid;
+}
+
+bool JournalReplay::readSeed(const uint8_t* record, size_t length) {
+    bool valid = length >= 6;
+
+    if (valid) {
+        uint32_t bits = record[0] | record[1] << 8 | record[2] << 16 | (uint32_t) record[3] << 24;
+        unsigned int numberOfPlayers = record[5];
+        size_t position = 6;
+
+        seed = (int) bits;
+        numberOfCentres = record[4];
+
+        for (unsigned int i = 0; i != numberOfPlayers && valid; ++i) {
+            valid = position < length && position + 1 + record[position] <= length;
+
+            if (valid) {
+                names.push_back(string((const char*) record + position + 1, record[position]));
+                position += 1 + record[position];
+            }
+        }
+
+        // The lowest int asks createNewGame for a random game
+        valid = valid && numberOfCentres >= 1 && numberOfCentres <= 2 &&
+                numberOfPlayers >= 2 && numberOfPlayers <= 4 &&
+                seed != std::numeric_limits<int>::min();
+        seeded = valid;
+    }
+
+    return valid;
+}
+
+bool JournalReplay::restore(const Checkpoint& checkpoint, GameModel& gameModel) {
+    bool valid = false;
+
+    if (checkpoint.size != 0) {
+        valid = CompactSave::decode(data.data() + checkpoint.offset, checkpoint.size, gameModel);
+    } else if (seeded) {
+        ModelBuilder(gameModel).createNewGame(numberOfCentres, names.data(), names.size(), seed);
+        GameRules(gameModel).startGame();
+        valid = gameModel.validate();
+    }
+
+    return valid;
+}
@@ -0,0 +1,76 @@
+/*
+ * Journal Replay
+ * 
+ * Reads back a journal written by MoveJournal, and rebuilds the position
+ * after any number of its moves, starting from the nearest checkpoint at or
+ * before it and playing the moves since. Seeking is deterministic: the same
+ * journal always gives the same positions.
+ * 
+ * Authors: C. Hodgen (s3031209), J. Osrecak (s3782455)
+ */
+
+#ifndef JOURNAL_REPLAY_H
+#define JOURNAL_REPLAY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "GameModel.h"
+#include "Move.h"
+
+class JournalReplay {
+    public:
+        JournalReplay();
+
+        // Read a journal, returning false if it cannot be opened or is not a
+        // journal. A partial record at the end is ignored.
+        bool load(const std::string& fileName);
+        bool read(const uint8_t* data, size_t size);
+
+        // Number of moves in the journal
+        unsigned int getNumberOfMoves();
+
+        Move getMove(unsigned int index);
+
+        // True if the game was started from a seed, rather than a position
+        bool hasSeed();
+        int getSeed();
+
+        // Rebuild the position after the first turn moves into a freshly
+        // made model. Returns false if turn is past the end, or the journal
+        // does not hold a valid game up to that point.
+        bool seek(unsigned int turn, GameModel& gameModel);
+
+    private:
+        // A position that can be restored directly
+        struct Checkpoint {
+            // Number of moves played before it
+            unsigned int turn;
+
+            // Where its compact save is kept in data
+            size_t offset;
+            size_t size;
+        };
+
+        // The whole journal
+        std::vector<uint8_t> data;
+
+        std::vector<Move> moves;
+        std::vector<Checkpoint> checkpoints;
+
+        // The start of a game made from a seed
+        bool seeded;
+        int seed;
+        int numberOfCentres;
+        std::vector<std::string> names;
+
+        // Read the record of a game started from a seed
+        bool readSeed(const uint8_t* record, size_t length);
+
+        // Rebuild the position at a checkpoint, or the start of the game
+        bool restore(const Checkpoint& checkpoint, GameModel& gameModel);
+};
+
+#endif // JOURNAL_REPLAY_H
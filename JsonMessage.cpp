@@ -0,0 +1,260 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#include "JsonMessage.h"
+
+using std::string;
+
+JsonMessage::JsonMessage() {}
+
+bool JsonMessage::parse(const string& text, string& error) {
+    size_t position = 0;
+    bool valid = true;
+    bool more = true;
+
+    fields.clear();
+
+    skipSpace(text, position);
+    valid = position < text.size() && text[position] == '{';
+    ++position;
+    skipSpace(text, position);
+
+    if (valid && position < text.size() && text[position] == '}') {
+        ++position;
+        more = false;
+    }
+
+    while (valid && more) {
+        Field field;
+
+        skipSpace(text, position);
+        valid = position < text.size() && text[position] == '"' && readString(text, position, field.key);
+        skipSpace(text, position);
+        valid = valid && position < text.size() && text[position] == ':';
+        ++position;
+        skipSpace(text, position);
+
+        if (!valid || position >= text.size()) {
+            valid = false;
+        } else if (text[position] == '"') {
+            size_t start = position;
+
+            field.type = JSON_STRING;
+            valid = readString(text, position, field.value);
+            field.raw = text.substr(start, position - start);
+        } else if (text[position] == '{' || text[position] == '[') {
+            error = "Nested objects and arrays are not supported";
+            valid = false;
+        } else {
+            valid = readLiteral(text, position, field);
+        }
+
+        skipSpace(text, position);
+
+        if (valid && position < text.size() && text[position] == ',') {
+            ++position;
+        } else if (valid && position < text.size() && text[position] == '}') {
+            ++position;
+            more = false;
+        } else {
+            valid = false;
+        }
+
+        if (valid) {
+            fields.push_back(field);
+        }
+    }
+
+    skipSpace(text, position);
+    valid = valid && position == text.size();
+
+    if (!valid && error.empty()) {
+        error = "Not a JSON object";
+    }
+
+    return valid;
+}
+
+bool JsonMessage::has(const string& key) const {
+    return find(key) != nullptr;
+}
+
+string JsonMessage::getString(const string& key, const string& fallback) const {
+    const Field* field = find(key);
+
+    return field != nullptr && field->type == JSON_STRING ? field->value : fallback;
+}
+
+long JsonMessage::getNumber(const string& key, long fallback) const {
+    const Field* field = find(key);
+
+    return field != nullptr && field->type == JSON_NUMBER ? strtol(field->value.c_str(), nullptr, 10) : fallback;
+}
+
+bool JsonMessage::getBool(const string& key, bool fallback) const {
+    const Field* field = find(key);
+    bool result = fallback;
+
+    if (field != nullptr && field->type == JSON_TRUE) {
+        result = true;
+    } else if (field != nullptr && field->type == JSON_FALSE) {
+        result = false;
+    }
+
+    return result;
+}
+
+string JsonMessage::getRaw(const string& key) const {
+    const Field* field = find(key);
+
+    return field != nullptr ? field->raw : "";
+}
+
+void JsonMessage::appendString(string& output, const string& value) {
+    output += '"';
+
+    for (char c : value) {
+        if (c == '"' || c == '\\') {
+            output += '\\';
+            output += c;
+        } else if (c == '\n') {
+            output += "\\n";
+        } else if (c == '\t') {
+            output += "\\t";
+        } else if ((unsigned char) c < 0x20) {
+            char escape[8];
+            snprintf(escape, sizeof(escape), "\\u%04x", (unsigned int) (unsigned char) c);
+            output += escape;
+        } else {
+            output += c;
+        }
+    }
+
+    output += '"';
+}
+
+void JsonMessage::appendKey(string& output, const char* key) {
+    if (!output.empty() && output.back() != '{' && output.back() != '[') {
+        output += ',';
+    }
+
+    output += '"';
+    output += key;
+    output += "\":";
+}
+
+const JsonMessage::Field* JsonMessage::find(const string& key) const {
+    const Field* found = nullptr;
+
+    // Messages have a handful of fields, so a search is quicker than a map
+    for (unsigned int i = 0; i != fields.size() && found == nullptr; ++i) {
+        if (fields[i].key == key) {
+            found = &fields[i];
+        }
+    }
+
+    return found;
+}
+
+bool JsonMessage::readString(const string& text, size_t& position, string& value) {
+    bool valid = true;
+    bool reading = true;
+
+    // Skip the opening quote
+    ++position;
+
+    while (valid && reading) {
+        if (position >= text.size() || (unsigned char) text[position] < 0x20) {
+            valid = false;
+        } else if (text[position] == '"') {
+            reading = false;
+        } else if (text[position] != '\\') {
+            value += text[position];
+        } else if (position + 1 >= text.size()) {
+            valid = false;
+        } else {
+            ++position;
+            char escape = text[position];
+
+            if (escape == '"' || escape == '\\' || escape == '/') {
+                value += escape;
+            } else if (escape == 'b') {
+                value += '\b';
+            } else if (escape == 'f') {
+                value += '\f';
+            } else if (escape == 'n') {
+                value += '\n';
+            } else if (escape == 'r') {
+                value += '\r';
+            } else if (escape == 't') {
+                value += '\t';
+            } else if (escape == 'u' && position + 4 < text.size()) {
+                char digits[5] = { text[position + 1], text[position + 2], text[position + 3], text[position + 4], '\0' };
+                char* end = nullptr;
+                unsigned long code = strtoul(digits, &end, 16);
+
+                valid = end == digits + 4;
+                position += 4;
+
+                // Names are the only strings that might need more than
+                // ASCII, and are written back as UTF-8. Characters outside
+                // the basic plane are not needed, so surrogates are refused.
+                if (code >= 0xD800 && code <= 0xDFFF) {
+                    valid = false;
+                } else if (code < 0x80) {
+                    value += (char) code;
+                } else if (code < 0x800) {
+                    value += (char) (0xC0 | (code >> 6));
+                    value += (char) (0x80 | (code & 0x3F));
+                } else {
+                    value += (char) (0xE0 | (code >> 12));
+                    value += (char) (0x80 | ((code >> 6) & 0x3F));
+                    value += (char) (0x80 | (code & 0x3F));
+                }
+            } else {
+                valid = false;
+            }
+        }
+
+        ++position;
+    }
+
+    return valid;
+}
+
+bool JsonMessage::readLiteral(const string& text, size_t& position, Field& field) {
+    bool valid = true;
+    size_t start = position;
+
+    while (position < text.size() && strchr("+-.0123456789eEtrufalsn", text[position]) != nullptr) {
+        ++position;
+    }
+
+    field.raw = text.substr(start, position - start);
+    field.value = field.raw;
+
+    if (field.raw == "true") {
+        field.type = JSON_TRUE;
+    } else if (field.raw == "false") {
+        field.type = JSON_FALSE;
+    } else if (field.raw == "null") {
+        field.type = JSON_NULL;
+    } else {
+        char* end = nullptr;
+
+        strtod(field.raw.c_str(), &end);
+        field.type = JSON_NUMBER;
+        valid = !field.raw.empty() && end == field.raw.c_str() + field.raw.size();
+    }
+
+    return valid;
+}
+
+void JsonMessage::skipSpace(const string& text, size_t& position) {
+    while (position < text.size() &&
+           (text[position] == ' ' || text[position] == '\t' || text[position] == '\r' || text[position] == '\n')) {
+        ++position;
+    }
+}
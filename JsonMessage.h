@@ -0,0 +1,79 @@
+/*
+ * JSON Message
+ *
+ * One line of the bot protocol: a flat JSON object, whose values are
+ * strings, numbers, true, false or null. Nested objects and arrays are not
+ * needed by any command, so they are turned away. Also holds the helpers
+ * for writing JSON replies straight into a string.
+ *
+ * Authors: C. Hodgen (s3031209), J. Osrecak (s3782455)
+ */
+
+#ifndef JSON_MESSAGE_H
+#define JSON_MESSAGE_H
+
+#include <string>
+#include <vector>
+
+class JsonMessage {
+    public:
+        JsonMessage();
+
+        // Read a message, replacing any read before. Returns false, with
+        // the reason in error, if it is not a flat JSON object.
+        bool parse(const std::string& text, std::string& error);
+
+        bool has(const std::string& key) const;
+
+        // Value of a string field, or fallback if there isn't one
+        std::string getString(const std::string& key, const std::string& fallback) const;
+
+        // Value of a number field, or fallback if there isn't one
+        long getNumber(const std::string& key, long fallback) const;
+
+        // Value of a true or false field, or fallback if there isn't one
+        bool getBool(const std::string& key, bool fallback) const;
+
+        // The field's value as it was written, or empty if there isn't one.
+        // Used to echo a request's id back unchanged.
+        std::string getRaw(const std::string& key) const;
+
+        // Add a value to a reply as a quoted JSON string
+        static void appendString(std::string& output, const std::string& value);
+
+        // Add "key": to a reply, after a comma unless it is the first field
+        static void appendKey(std::string& output, const char* key);
+
+    private:
+        enum ValueType {
+            JSON_STRING,
+            JSON_NUMBER,
+            JSON_TRUE,
+            JSON_FALSE,
+            JSON_NULL
+        };
+
+        struct Field {
+            std::string key;
+
+            // Strings are kept unescaped, anything else as written
+            std::string value;
+            std::string raw;
+            ValueType type;
+        };
+
+        std::vector<Field> fields;
+
+        const Field* find(const std::string& key) const;
+
+        // Read a string starting at the opening quote, leaving position
+        // after the closing quote
+        static bool readString(const std::string& text, size_t& position, std::string& value);
+
+        // Read a number, true, false or null
+        static bool readLiteral(const std::string& text, size_t& position, Field& field);
+
+        static void skipSpace(const std::string& text, size_t& position);
+};
+
+#endif // JSON_MESSAGE_H
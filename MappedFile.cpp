@@ -0,0 +1,57 @@
+#include <string>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "MappedFile.h"
+
+using std::string;
+
+MappedFile::MappedFile(const string& fileName) :
+    data(nullptr),
+    size(0),
+    open(false)
+{
+    int file = ::open(fileName.c_str(), O_RDONLY);
+
+    if (file != -1) {
+        struct stat status;
+
+        if (fstat(file, &status) == 0 && S_ISREG(status.st_mode)) {
+            if (status.st_size == 0) {
+                open = true;
+            } else {
+                void* mapped = mmap(nullptr, status.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+
+                if (mapped != MAP_FAILED) {
+                    data = (const uint8_t*) mapped;
+                    size = status.st_size;
+                    open = true;
+                }
+            }
+        }
+
+        // The mapping stays valid once the descriptor is closed
+        close(file);
+    }
+}
+
+MappedFile::~MappedFile() {
+    if (data != nullptr) {
+        munmap((void*) data, size);
+    }
+}
+
+bool MappedFile::isOpen() {
+    return open;
+}
+
+const uint8_t* MappedFile::getData() {
+    return data;
+}
+
+size_t MappedFile::getSize() {
+    return size;
+}
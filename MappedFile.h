@@ -0,0 +1,38 @@
+/*
+ * Mapped File
+ * 
+ * A read only view of a whole file, mapped into memory for as long as the
+ * object lives, so a file can be parsed in place without copying it.
+ * 
+ * Authors: C. Hodgen (s3031209), J. Osrecak (s3782455)
+ */
+
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+class MappedFile {
+    public:
+        MappedFile(const std::string& fileName);
+        ~MappedFile();
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        // True if the file could be opened. An empty file is open, with no
+        // data.
+        bool isOpen();
+
+        const uint8_t* getData();
+        size_t getSize();
+
+    private:
+        const uint8_t* data;
+        size_t size;
+        bool open;
+};
+
+#endif // MAPPED_FILE_H
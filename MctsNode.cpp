@@ -0,0 +1,153 @@
+#include <atomic>
+#include <cmath>
+
+#include "MctsNode.h"
+
+#define MCTS_UNEXPANDED 0
+#define MCTS_EXPANDING  1
+#define MCTS_EXPANDED   2
+
+MctsNode::MctsNode() :
+    move(),
+    player(-1),
+    chance(false),
+    visits(0),
+    virtualLoss(0),
+    reward(0),
+    state(MCTS_UNEXPANDED),
+    children(nullptr),
+    numberOfChildren(0),
+    outcomesClaimed(0),
+    outcome(nullptr),
+    outcomeReady(false)
+{}
+
+MctsNode::~MctsNode() {
+    delete[] children;
+    delete outcome;
+}
+
+void MctsNode::initialise(Move move, int player, bool chance) {
+    this->move = move;
+    this->player = player;
+    this->chance = chance;
+}
+
+Move MctsNode::getMove() {
+    return move;
+}
+
+int MctsNode::getPlayer() {
+    return player;
+}
+
+bool MctsNode::isChance() {
+    return chance;
+}
+
+bool MctsNode::tryExpand() {
+    int expected = MCTS_UNEXPANDED;
+
+    return state.compare_exchange_strong(expected, MCTS_EXPANDING);
+}
+
+bool MctsNode::isExpanded() {
+    return state.load(std::memory_order_acquire) == MCTS_EXPANDED;
+}
+
+void MctsNode::setChildren(MctsNode* children, unsigned int numberOfChildren) {
+    this->children = children;
+    this->numberOfChildren = numberOfChildren;
+
+    // Readers check the state before touching the children
+    state.store(MCTS_EXPANDED, std::memory_order_release);
+}
+
+unsigned int MctsNode::getNumberOfChildren() {
+    return numberOfChildren;
+}
+
+MctsNode* MctsNode::getChild(unsigned int index) {
+    return &children[index];
+}
+
+MctsNode* MctsNode::selectChild(double exploration) {
+    MctsNode* best = nullptr;
+    double bestScore = 0;
+    double logVisits = std::log((double) (visits.load() + virtualLoss.load() + 1));
+
+    for (unsigned int i = 0; i != numberOfChildren && (best == nullptr || bestScore != HUGE_VAL); ++i) {
+        MctsNode* child = &children[i];
+        int childVisits = child->visits.load() + child->virtualLoss.load();
+        double score = HUGE_VAL;
+
+        // Unvisited children are always tried first
+        if (childVisits != 0) {
+            double mean = (double) child->reward.load() / MCTS_REWARD_ONE / childVisits;
+            score = mean + exploration * std::sqrt(logVisits / childVisits);
+        }
+
+        if (best == nullptr || score > bestScore) {
+            best = child;
+            bestScore = score;
+        }
+    }
+
+    return best;
+}
+
+MctsNode* MctsNode::getMostVisitedChild() {
+    MctsNode* best = nullptr;
+
+    for (unsigned int i = 0; i != numberOfChildren; ++i) {
+        if (best == nullptr || children[i].visits.load() > best->visits.load()) {
+            best = &children[i];
+        }
+    }
+
+    return best;
+}
+
+int MctsNode::claimOutcome() {
+    int slot = outcomesClaimed.fetch_add(1);
+
+    if (slot >= MCTS_MAX_OUTCOMES || (unsigned int) slot >= numberOfChildren) {
+        slot = -1;
+    }
+
+    return slot;
+}
+
+void MctsNode::setOutcome(GameModel& gameModel) {
+    outcome = new GameState();
+    gameModel.saveState(*outcome);
+    outcomeReady.store(true, std::memory_order_release);
+}
+
+bool MctsNode::hasOutcome() {
+    return outcomeReady.load(std::memory_order_acquire);
+}
+
+const GameState& MctsNode::getOutcome() {
+    return *outcome;
+}
+
+void MctsNode::addVirtualLoss() {
+    virtualLoss.fetch_add(1);
+}
+
+void MctsNode::update(double value) {
+    reward.fetch_add((int64_t) (value * MCTS_REWARD_ONE));
+    visits.fetch_add(1);
+    virtualLoss.fetch_sub(1);
+}
+
+int MctsNode::getVisits() {
+    return visits.load();
+}
+
+double MctsNode::getMeanReward() {
+    int count = visits.load();
+
+    return count == 0 ? 0 : (double) reward.load() / MCTS_REWARD_ONE / count;
+}
@@ -0,0 +1,112 @@
+/*
+ * MCTS Node
+ * 
+ * One node of a Monte Carlo search tree, shared by every search thread.
+ * Statistics are atomic, and children are published once, by the thread
+ * that wins the right to expand the node.
+ * 
+ * A decision node has one child per legal move. A chance node is reached by
+ * a move that ends the round, and its children are positions sampled from
+ * the refill of the factories, up to MCTS_MAX_OUTCOMES of them.
+ * 
+ * Authors: C. Hodgen (s3031209), J. Osrecak (s3782455)
+ */
+
+#ifndef MCTS_NODE_H
+#define MCTS_NODE_H
+
+#include <atomic>
+#include <cstdint>
+
+#include "GameModel.h"
+#include "GameState.h"
+#include "Move.h"
+
+// Most refills sampled below one chance node
+#define MCTS_MAX_OUTCOMES   8
+
+// Fixed point value of a reward of 1, so rewards can be summed atomically
+#define MCTS_REWARD_ONE     (1 << 20)
+
+class MctsNode {
+    public:
+        MctsNode();
+        ~MctsNode();
+
+        // Set up a child for the move, made by the given player. A chance
+        // child samples the refill that follows its move.
+        void initialise(Move move, int player, bool chance);
+
+        // Move that led to this node
+        Move getMove();
+
+        // Player who made the move, or -1 for the root and sampled outcomes
+        int getPlayer();
+
+        bool isChance();
+
+        // Claim the right to expand this node. Only one thread ever succeeds.
+        bool tryExpand();
+
+        // True once the children have been published
+        bool isExpanded();
+
+        // Publish the children, taking ownership of the array
+        void setChildren(MctsNode* children, unsigned int numberOfChildren);
+
+        unsigned int getNumberOfChildren();
+
+        MctsNode* getChild(unsigned int index);
+
+        // Child with the best upper confidence bound, counting virtual losses
+        // as visits with no reward
+        MctsNode* selectChild(double exploration);
+
+        // Child with the most visits
+        MctsNode* getMostVisitedChild();
+
+        // Claim the next free outcome of a chance node, or -1 if all are used
+        int claimOutcome();
+
+        // Record the sampled position of an outcome, making it visible
+        void setOutcome(GameModel& gameModel);
+
+        // True once the outcome position has been recorded
+        bool hasOutcome();
+
+        const GameState& getOutcome();
+
+        // Mark a thread as passing through, to steer others elsewhere
+        void addVirtualLoss();
+
+        // Count a visit with the given reward, and remove the virtual loss
+        void update(double reward);
+
+        int getVisits();
+
+        // Mean reward over all visits
+        double getMeanReward();
+
+    private:
+        Move move;
+        int player;
+        bool chance;
+
+        std::atomic<int> visits;
+        std::atomic<int> virtualLoss;
+        std::atomic<int64_t> reward;
+
+        // MCTS_UNEXPANDED, MCTS_EXPANDING or MCTS_EXPANDED
+        std::atomic<int> state;
+        MctsNode* children;
+        unsigned int numberOfChildren;
+
+        // Outcomes claimed below a chance node
+        std::atomic<int> outcomesClaimed;
+
+        // Sampled position of an outcome, and whether it has been written
+        GameState* outcome;
+        std::atomic<bool> outcomeReady;
+};
+
+#endif // MCTS_NODE_H
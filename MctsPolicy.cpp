@@ -0,0 +1,258 @@
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "MctsPolicy.h"
+#include "ModelBuilder.h"
+
+using std::thread;
+using std::vector;
+
+MctsPolicy::MctsPolicy(unsigned int seed, unsigned int threads, unsigned long playouts, unsigned int milliseconds) :
+    seed(seed),
+    threads(threads),
+    playoutBudget(playouts),
+    milliseconds(milliseconds),
+    searches(0),
+    playouts(0),
+    completed(0)
+{
+    if (this->threads == 0) {
+        this->threads = thread::hardware_concurrency();
+    }
+    if (this->threads == 0) {
+        this->threads = 1;
+    }
+}
+
+Move MctsPolicy::chooseMove(GameModel& gameModel, Move* moves, unsigned int numberOfMoves) {
+    GameState rootState;
+    gameModel.saveState(rootState);
+
+    MctsNode root;
+    GameRules rules(gameModel);
+    expand(&root, moves, numberOfMoves, gameModel.getCurrentPlayerIndex(), rules);
+
+    playouts = 0;
+    completed = 0;
+    deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(milliseconds);
+    ++searches;
+
+    vector<thread> workers;
+    for (unsigned int i = 0; i != threads; ++i) {
+        unsigned int threadSeed = seed * 7919u + searches * 104729u + i;
+        workers.push_back(thread(&MctsPolicy::search, this, &root, std::cref(rootState), threadSeed));
+    }
+
+    for (thread& worker : workers) {
+        worker.join();
+    }
+
+    return root.getMostVisitedChild()->getMove();
+}
+
+unsigned long MctsPolicy::getPlayouts() {
+    return completed.load();
+}
+
+void MctsPolicy::search(MctsNode* root, const GameState& rootState, unsigned int threadSeed) {
+    // Every thread plays on its own copy of the game
+    GameModel gameModel;
+    ModelBuilder(gameModel).loadState(rootState);
+    GameRules rules(gameModel);
+    MoveGenerator moveGenerator(gameModel);
+    std::mt19937 engine(threadSeed);
+
+    while (hasBudget()) {
+        playout(root, gameModel, rules, moveGenerator, engine);
+        completed.fetch_add(1);
+    }
+}
+
+bool MctsPolicy::hasBudget() {
+    bool budget = true;
+
+    if (playoutBudget != 0 && playouts.fetch_add(1) >= playoutBudget) {
+        budget = false;
+    } else if (playoutBudget == 0 || milliseconds != 0) {
+        budget = std::chrono::steady_clock::now() < deadline;
+    }
+
+    return budget;
+}
+
+void MctsPolicy::playout(MctsNode* root, GameModel& gameModel, GameRules& rules,
+                         MoveGenerator& moveGenerator, std::mt19937& engine) {
+    vector<MctsNode*> path;
+    MctsNode* node = root;
+    MoveResult result = MOVE_PLAYED;
+    bool descending = true;
+
+    root->addVirtualLoss();
+    path.push_back(root);
+
+    while (descending) {
+        MctsNode* next = nullptr;
+
+        if (result == GAME_OVER) {
+            descending = false;
+        } else if (node->isChance() && result == ROUND_OVER) {
+            // The refill has just been sampled. Keep it as a new outcome if
+            // there is room, otherwise carry on from a known outcome.
+            if (!node->isExpanded() && node->tryExpand()) {
+                node->setChildren(new MctsNode[MCTS_MAX_OUTCOMES], MCTS_MAX_OUTCOMES);
+            }
+
+            if (node->isExpanded()) {
+                int slot = node->claimOutcome();
+
+                if (slot != -1) {
+                    next = node->getChild(slot);
+                    next->setOutcome(gameModel);
+                } else {
+                    std::uniform_int_distribution<unsigned int> pick(0, MCTS_MAX_OUTCOMES - 1);
+                    MctsNode* outcome = node->getChild(pick(engine));
+
+                    if (outcome->hasOutcome()) {
+                        next = outcome;
+                        ModelBuilder(gameModel).loadState(next->getOutcome());
+                    }
+                }
+            }
+
+            if (next != nullptr) {
+                // The outcome is a position like any other, so the move
+                // below it is chosen as usual
+                result = MOVE_PLAYED;
+            } else {
+                // No outcome to follow yet, so judge the round as scored
+                descending = false;
+            }
+        } else if (!node->isExpanded()) {
+            if (node->tryExpand()) {
+                Move moves[MAX_MOVES];
+                unsigned int numberOfMoves = moveGenerator.generateDistinct(moves);
+
+                expand(node, moves, numberOfMoves, gameModel.getCurrentPlayerIndex(), rules);
+
+                // Take one step into the new children, then roll out
+                if (numberOfMoves != 0) {
+                    next = node->selectChild(MCTS_EXPLORATION);
+                    result = applyMove(next->getMove(), gameModel, rules, engine);
+                }
+            }
+
+            descending = false;
+        } else if (node->getNumberOfChildren() != 0) {
+            next = node->selectChild(MCTS_EXPLORATION);
+            result = applyMove(next->getMove(), gameModel, rules, engine);
+        } else {
+            descending = false;
+        }
+
+        if (next != nullptr) {
+            next->addVirtualLoss();
+            path.push_back(next);
+            node = next;
+        }
+    }
+
+    // A round that has just been scored is judged as it stands, otherwise
+    // play on to the end of the round
+    bool roundScored = result != MOVE_PLAYED;
+    if (!roundScored) {
+        roundScored = rollout(gameModel, rules, moveGenerator, engine) != MOVE_PLAYED;
+    }
+
+    double rewards[MAX_STATE_PLAYERS];
+    evaluate(gameModel, roundScored, rewards);
+
+    for (MctsNode* visited : path) {
+        int player = visited->getPlayer();
+        visited->update(player == -1 ? 0 : rewards[player]);
+    }
+
+    // Walk the model back to the root
+    while (rules.getHistorySize() != 0) {
+        rules.undoMove();
+    }
+}
+
+MoveResult MctsPolicy::rollout(GameModel& gameModel, GameRules& rules,
+                               MoveGenerator& moveGenerator, std::mt19937& engine) {
+    MoveResult result = MOVE_PLAYED;
+    Move moves[MAX_MOVES];
+    unsigned int numberOfMoves = moveGenerator.generate(moves);
+
+    while (result == MOVE_PLAYED && numberOfMoves != 0) {
+        // Random moves, but never straight to the floor when a pattern line
+        // would take the tiles
+        unsigned int kept = 0;
+        for (unsigned int i = 0; i != numberOfMoves; ++i) {
+            if (moves[i].getDestination() != MOVE_FLOOR_LINE) {
+                moves[kept] = moves[i];
+                ++kept;
+            }
+        }
+        if (kept != 0) {
+            numberOfMoves = kept;
+        }
+
+        std::uniform_int_distribution<unsigned int> pick(0, numberOfMoves - 1);
+        result = applyMove(moves[pick(engine)], gameModel, rules, engine);
+
+        if (result == MOVE_PLAYED) {
+            numberOfMoves = moveGenerator.generate(moves);
+        }
+    }
+
+    return result;
+}
+
+MoveResult MctsPolicy::applyMove(Move move, GameModel& gameModel, GameRules& rules, std::mt19937& engine) {
+    if (rules.endsRound(move)) {
+        gameModel.getTileBag()->shuffle(engine);
+        gameModel.getBoxLid()->shuffle(engine);
+    }
+
+    return rules.applyMove(move);
+}
+
+void MctsPolicy::expand(MctsNode* node, Move* moves, unsigned int numberOfMoves, int player, GameRules& rules) {
+    MctsNode* children = nullptr;
+
+    if (numberOfMoves != 0) {
+        children = new MctsNode[numberOfMoves];
+
+        for (unsigned int i = 0; i != numberOfMoves; ++i) {
+            children[i].initialise(moves[i], player, rules.endsRound(moves[i]));
+        }
+    }
+
+    node->setChildren(children, numberOfMoves);
+}
+
+void MctsPolicy::evaluate(GameModel& gameModel, bool roundScored, double* rewards) {
+    int numberOfPlayers = gameModel.getNumberOfPlayers();
+    GameRules rules(gameModel);
+    int scores[MAX_STATE_PLAYERS];
+
+    for (int i = 0; i != numberOfPlayers; ++i) {
+        scores[i] = roundScored ? gameModel.getAllPlayers()[i]->getScore() : rules.getProjectedScore(i);
+    }
+
+    for (int i = 0; i != numberOfPlayers; ++i) {
+        int bestOther = -1;
+
+        for (int j = 0; j != numberOfPlayers; ++j) {
+            if (j != i && (bestOther == -1 || scores[j] > bestOther)) {
+                bestOther = scores[j];
+            }
+        }
+
+        rewards[i] = 1.0 / (1.0 + std::exp((bestOther - scores[i]) / MCTS_REWARD_SCALE));
+    }
+}
@@ -0,0 +1,93 @@
+/*
+ * MCTS Policy
+ * 
+ * Chooses moves by Monte Carlo Tree Search. Several threads search one
+ * shared tree, each on its own copy of the game, using virtual loss to
+ * spread out. Each playout runs to the end of the round and scores the
+ * position by how far each player leads or trails the best of the rest.
+ * 
+ * The order of the bag is hidden from the players, so it is shuffled
+ * before every move that refills the factories, and the refill is treated
+ * as a chance node.
+ * 
+ * The search stops when the playout budget or the time budget runs out,
+ * whichever comes first. A budget of 0 is no limit.
+ * 
+ * Authors: C. Hodgen (s3031209), J. Osrecak (s3782455)
+ */
+
+#ifndef MCTS_POLICY_H
+#define MCTS_POLICY_H
+
+#include <atomic>
+#include <chrono>
+#include <random>
+#include <vector>
+
+#include "GameModel.h"
+#include "GameRules.h"
+#include "MctsNode.h"
+#include "MoveGenerator.h"
+#include "Policy.h"
+
+// Time given to each move, unless a playout budget is given instead
+#define MCTS_DEFAULT_MILLISECONDS   500
+
+// Weight of exploration against the mean reward in the tree policy
+#define MCTS_EXPLORATION            0.7
+
+// Score lead that is worth a reward of about 0.73
+#define MCTS_REWARD_SCALE           10.0
+
+class MctsPolicy : public Policy {
+    public:
+        // A thread count of 0 uses one per core
+        MctsPolicy(unsigned int seed, unsigned int threads, unsigned long playouts, unsigned int milliseconds);
+
+        Move chooseMove(GameModel& gameModel, Move* moves, unsigned int numberOfMoves);
+
+        // Playouts run by the last search
+        unsigned long getPlayouts();
+
+    private:
+        unsigned int seed;
+        unsigned int threads;
+        unsigned long playoutBudget;
+        unsigned int milliseconds;
+
+        // Number of searches made, so each search uses fresh random numbers
+        unsigned int searches;
+
+        // Shared by the threads during a search: playouts started, and
+        // playouts finished
+        std::atomic<unsigned long> playouts;
+        std::atomic<unsigned long> completed;
+        std::chrono::steady_clock::time_point deadline;
+
+        // Search from the root until the budget runs out
+        void search(MctsNode* root, const GameState& rootState, unsigned int threadSeed);
+
+        // Run one playout: select down the tree, expand, roll out to the end
+        // of the round and back the result up
+        void playout(MctsNode* root, GameModel& gameModel, GameRules& rules,
+                     MoveGenerator& moveGenerator, std::mt19937& engine);
+
+        // Play moves until the round ends. Returns what the last move led to.
+        MoveResult rollout(GameModel& gameModel, GameRules& rules,
+                           MoveGenerator& moveGenerator, std::mt19937& engine);
+
+        // Apply a move, shuffling the bag and lid first if it refills the
+        // factories
+        MoveResult applyMove(Move move, GameModel& gameModel, GameRules& rules, std::mt19937& engine);
+
+        // Give each child of a node one of the moves
+        void expand(MctsNode* node, Move* moves, unsigned int numberOfMoves, int player, GameRules& rules);
+
+        // Reward for each player in the current position
+        void evaluate(GameModel& gameModel, bool roundScored, double* rewards);
+
+        // True while there is budget left
+        bool hasBudget();
+};
+
+#endif // MCTS_POLICY_H
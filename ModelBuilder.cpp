@@ -1,22 +1,21 @@
 
+#include <cstring>
 #include <iostream>
-#include <map>
 #include <string>
 #include <random>
 
 #include "BoxLid.h"
+#include "CompactSave.h"
 #include "GameModel.h"
+#include "MappedFile.h"
 #include "ModelBuilder.h"
 #include "Player.h"
 #include "TileBag.h"
 
-using std::map;
 using std::make_shared;
 using std::make_unique;
 using std::move;
-using std::pair;
 using std::shared_ptr;
-using std::stoi;
 using std::string;
 using std::unique_ptr;
 
@@ -24,165 +23,250 @@ ModelBuilder::ModelBuilder(GameModel& gameModel) :
     gameModel(gameModel)
 {}
 
-void ModelBuilder::loadSaveData(map<string, string>& rawData) {
+bool ModelBuilder::loadSaveText(const char* text, size_t length) {
+    bool valid = true;
+    const char* end = text + length;
+    const char* line = text;
 
-    for(const pair<string, string>& item : rawData) {
-        parseAndLoadDataPair(item.first, item.second);
+    while (valid && line != end) {
+        const char* lineEnd = (const char*) memchr(line, '\n', end - line);
+        const char* next = lineEnd == nullptr ? end : lineEnd + 1;
+
+        if (lineEnd == nullptr) {
+            lineEnd = end;
+        }
+
+        if (lineEnd != line && lineEnd[-1] == '\r') {
+            --lineEnd;
+        }
+
+        if (lineEnd != line && *line != COMMENT_MARKER) {
+            const char* delimiter = (const char*) memchr(line, KEY_VALUE_DELIMITER[0], lineEnd - line);
+
+            if (delimiter == nullptr) {
+                valid = false;
+            } else {
+                TextSpan key = { line, (size_t) (delimiter - line) };
+                TextSpan value = { delimiter + 1, (size_t) (lineEnd - delimiter - 1) };
+                valid = loadTextPair(key, value);
+            }
+        }
+
+        line = next;
     }
 
-    for (auto player : tempPlayers) {
-        gameModel.addPlayer(player.second);
+    // Players and factories must run from 0 with no gaps
+    int numberOfPlayers = 0;
+    while (numberOfPlayers != MAX_STATE_PLAYERS && tempPlayers[numberOfPlayers] != nullptr) {
+        ++numberOfPlayers;
     }
 
-    for (unsigned int i = 0; i != tempFactories.size(); ++i) {
-        gameModel.addFactory(tempFactories[i]);
+    for (int i = numberOfPlayers; i != MAX_STATE_PLAYERS; ++i) {
+        valid = valid && tempPlayers[i] == nullptr;
     }
 
-    gameModel.setCurrentPlayer(tempPlayers[currentPlayerId]);
-}
+    int numberOfFactories = 0;
+    while (numberOfFactories != MAX_STATE_FACTORIES && tempFactories[numberOfFactories] != nullptr) {
+        ++numberOfFactories;
+    }
 
-void ModelBuilder::parseAndLoadDataPair(std::string key, std::string value) {
-    if (key == BAG_KEY) {
-        loadTileBag(value);
-    } else if (key == LID_KEY) {
-        loadBoxLid(value);
-    } else if (key.find(PLAYER_KEY) == 0) {
-        loadPlayerDataPair(key, value);
-    } else if (key == CURRENT_PLAYER_KEY) {
-        currentPlayerId = value;
-    } else if (key.find(FACTORY_KEY) == 0) {
-        loadFactory(key, value);
-    } else if (key.find(TABLE_KEY) == 0) {
-        loadFirstKey(value);
+    for (int i = numberOfFactories; i != MAX_STATE_FACTORIES; ++i) {
+        valid = valid && tempFactories[i] == nullptr;
     }
-}
 
-void ModelBuilder::loadTileBag(string& tileList) {
-    shared_ptr<TileBag> tileBag = gameModel.getTileBag();
+    valid = valid && currentPlayerId >= 0 && currentPlayerId < numberOfPlayers;
 
-    for (char colourCode : tileList) {
-        tileBag->add(make_unique<Tile>(getTileColourFromChar(colourCode)));
+    if (valid) {
+        for (int i = 0; i != numberOfPlayers; ++i) {
+            gameModel.addPlayer(tempPlayers[i]);
+        }
+
+        for (int i = 0; i != numberOfFactories; ++i) {
+            gameModel.addFactory(tempFactories[i]);
+        }
+
+        gameModel.setCurrentPlayer(tempPlayers[currentPlayerId]);
+        gameModel.refreshHash();
+        gameModel.refreshLedger();
     }
+
+    return valid;
 }
 
-void ModelBuilder::loadBoxLid(string& tileList) {
-    shared_ptr<BoxLid> lid = gameModel.getBoxLid();
+bool ModelBuilder::loadSaveFile(const string& fileName) {
+    bool loaded = false;
+    MappedFile file(fileName);
 
-    for (char colourCode : tileList) {
-        lid->add(make_unique<Tile>(getTileColourFromChar(colourCode)));
-    } 
+    if (file.isOpen()) {
+        if (CompactSave::isCompact(file.getData(), file.getSize())) {
+            loaded = CompactSave::decode(file.getData(), file.getSize(), gameModel);
+        } else {
+            loaded = loadSaveText((const char*) file.getData(), file.getSize())
+                     && gameModel.validate();
+        }
+    }
+
+    return loaded;
 }
 
-void ModelBuilder::loadFactory(string key, string tileList) {
-    // Drop the initial part of the key
-    key.erase(0, FACTORY_KEY.length() + KEY_SPLIT_DELIMITER.length());
+bool ModelBuilder::loadTextPair(TextSpan key, TextSpan value) {
+    bool valid = true;
+    int number = 0;
+
+    if (isKey(key, BAG_KEY)) {
+        loadTextTiles(*gameModel.getTileBag(), value);
+    } else if (isKey(key, LID_KEY)) {
+        loadTextTiles(*gameModel.getBoxLid(), value);
+    } else if (isKey(key, CURRENT_PLAYER_KEY)) {
+        valid = takeNumber(value, currentPlayerId) && value.length == 0;
+    } else if (takePrefix(key, PLAYER_KEY) && takePrefix(key, KEY_SPLIT_DELIMITER)) {
+        valid = loadTextPlayerPair(key, value);
+    } else if (takePrefix(key, FACTORY_KEY) && takePrefix(key, KEY_SPLIT_DELIMITER)) {
+        if (takePrefix(key, CENTRE_KEY) && takePrefix(key, KEY_SPLIT_DELIMITER)) {
+            valid = takeNumber(key, number) && key.length == 0 && number < MAX_STATE_CENTRES;
+
+            if (valid) {
+                while (gameModel.getNumberOfCentreFactories() <= number) {
+                    gameModel.addTableCentre();
+                }
+                loadTextTiles(*gameModel.getTableCentre(number), value);
+            }
+        } else {
+            valid = takeNumber(key, number) && key.length == 0 && number < MAX_STATE_FACTORIES;
+
+            if (valid) {
+                if (tempFactories[number] == nullptr) {
+                    tempFactories[number] = make_shared<Factory>();
+                }
+                loadTextTiles(*tempFactories[number], value);
+            }
+        }
+    } else if (takePrefix(key, TABLE_KEY)) {
+        if (memchr(value.start, 'F', value.length) != nullptr) {
+            gameModel.setFirstOnTable(true);
+        }
+    }
 
-    if (key.length() >= CENTRE_KEY.length()) {
+    return valid;
+}
 
-        gameModel.addTableCentre();
+bool ModelBuilder::loadTextPlayerPair(TextSpan key, TextSpan value) {
+    int playerId = 0;
+    int row = 0;
+    bool valid = takeNumber(key, playerId) && playerId < MAX_STATE_PLAYERS
+                 && takePrefix(key, KEY_SPLIT_DELIMITER);
 
-        for (char colourCode : tileList) {
+    if (valid) {
+        if (tempPlayers[playerId] == nullptr) {
+            tempPlayers[playerId] = make_shared<Player>();
+        }
 
-            TileColour tileColour = getTileColourFromChar(colourCode);
-            gameModel.getTableCentre(numberOfCentreFactories)->add(make_unique<Tile>(tileColour));
+        shared_ptr<Player> player = tempPlayers[playerId];
+        shared_ptr<PlayerBoard> board = player->getBoard();
 
-        }
+        if (isKey(key, PLAYER_NAME_KEY)) {
+            string name(value.start, value.length);
+            player->setName(name);
+        } else if (isKey(key, PLAYER_SCORE_KEY)) {
+            bool negative = value.length != 0 && *value.start == '-';
+            int score = 0;
 
-        ++numberOfCentreFactories;
-    } else {
-        // do standard factory
-        tempFactories[stoi(key)] = make_shared<Factory>();
-        for (char colourCode : tileList) {
+            if (negative) {
+                ++value.start;
+                --value.length;
+            }
 
-            TileColour tileColour = getTileColourFromChar(colourCode);
-            tempFactories[stoi(key)]->add(make_unique<Tile>(tileColour));
+            valid = takeNumber(value, score) && value.length == 0;
+            player->setScore(negative ? -score : score);
+        } else if (takePrefix(key, PLAYER_PATTERN_KEY) && takePrefix(key, KEY_SPLIT_DELIMITER)) {
+            valid = takeNumber(key, row) && key.length == 0 && row < 5;
+
+            for (size_t i = 0; valid && i != value.length; ++i) {
+                TileColour colour = getTileColourFromChar(value.start[i]);
+                if (colour != NONE) {
+                    board->addTileToPatternLine(colour, row);
+                }
+            }
+        } else if (isKey(key, PLAYER_FLOOR_KEY)) {
+            for (size_t i = 0; i != value.length; ++i) {
+                TileColour colour = getTileColourFromChar(value.start[i]);
+                if (colour != NONE) {
+                    board->addTileToFloorLine(colour);
+                }
+            }
+        } else if (takePrefix(key, PLAYER_WALL_KEY) && takePrefix(key, KEY_SPLIT_DELIMITER)) {
+            valid = takeNumber(key, row) && key.length == 0 && row < 5 && value.length <= 5;
+
+            if (valid) {
+                unsigned int bits = 0;
+                for (size_t i = 0; i != value.length; ++i) {
+                    if (getTileColourFromChar(value.start[i]) != NONE) {
+                        bits |= 1u << i;
+                    }
+                }
+
+                Mosaic& mosaic = board->getMosaic();
+                mosaic.setWall(mosaic.getWall() | bits << (row * 5));
+            }
         }
     }
+
+    return valid;
 }
 
-void ModelBuilder::loadPlayerDataPair(string key, string value) {
-    /**
-     * Split key
-     * check if player is in map
-     *   create and add player to map
-     * check data (pattern line, name, etc.)
-     * pass to specific player load method
-     */
-
-    // Drop the initial part of the key
-    key.erase(0, PLAYER_KEY.length() + KEY_SPLIT_DELIMITER.length());
-
-    string playerId = key.substr(0, key.find(KEY_SPLIT_DELIMITER));
-    shared_ptr<Player> player = nullptr;
-
-    // Retrieve player from map, or create one if necessary
-    auto search = tempPlayers.find(playerId);
-    if (search == tempPlayers.end()) {
-        player = make_shared<Player>();
-        tempPlayers[playerId] = player;
-    } else {
-        player = search->second;
+template <typename Container>
+void ModelBuilder::loadTextTiles(Container& container, TextSpan value) {
+    for (size_t i = 0; i != value.length; ++i) {
+        container.add(getTileColourFromChar(value.start[i]));
     }
+}
 
-    // Remove the player id from the key
-    string subKey = key.erase(0, playerId.length() + KEY_SPLIT_DELIMITER.length());
-
-    if(subKey == PLAYER_NAME_KEY) {
-        // Set name
-        player->setName(value);
-    } else if (subKey == PLAYER_SCORE_KEY) {
-        // Set score
-        player->setScore(stoi(value));
-    } else if (subKey.find(PLAYER_PATTERN_KEY) == 0) {
-        // Set pattern line
-        // Determine which line we're reading
-        int row = stoi(subKey.erase(0, PLAYER_PATTERN_KEY.length() + KEY_SPLIT_DELIMITER.length()));
-        loadPlayerPatternLine(player, row, value);
-    } else if (subKey.find(PLAYER_FLOOR_KEY) == 0) {
-        loadPlayerFloorLine(player, value);
-    } else if (subKey.find(PLAYER_WALL_KEY) == 0) {
-        // WALL_LINE_row
-        int row = stoi(subKey.erase(0, PLAYER_WALL_KEY.length() + KEY_SPLIT_DELIMITER.length()));
-        loadPlayerWallRow(player, row, value);
-    } else {
-        // unknown parameter
+bool ModelBuilder::takePrefix(TextSpan& span, const string& prefix) {
+    bool result = span.length >= prefix.length()
+                  && memcmp(span.start, prefix.data(), prefix.length()) == 0;
+
+    if (result) {
+        span.start += prefix.length();
+        span.length -= prefix.length();
     }
 
+    return result;
 }
 
-void ModelBuilder::loadPlayerPatternLine(shared_ptr<Player> player, int row, std::string tileList) {
-    for (char colourCode : tileList) {
-        TileColour tileColour = getTileColourFromChar(colourCode);
-        if (tileColour != NONE) {
-            player->getBoard()->addTileToPatternLine(make_unique<Tile>(tileColour), row);
-        }
+bool ModelBuilder::takeNumber(TextSpan& span, int& number) {
+    size_t digits = 0;
+    number = 0;
+
+    // Up to 9 digits, so the number cannot overflow
+    while (digits != span.length && digits != 9 && span.start[digits] >= '0' && span.start[digits] <= '9') {
+        number = number * 10 + (span.start[digits] - '0');
+        ++digits;
     }
+
+    span.start += digits;
+    span.length -= digits;
+
+    return digits != 0;
 }
 
-void ModelBuilder::loadPlayerFloorLine(std::shared_ptr<Player> player, std::string tileList) {
-    for (char colourCode : tileList) {
-        TileColour tileColour = getTileColourFromChar(colourCode);
-        if (tileColour != NONE) { 
-            player->getBoard()->addTileToFloorLine(make_unique<Tile>(tileColour));
-        }
-    }
+bool ModelBuilder::isKey(TextSpan span, const string& key) {
+    return span.length == key.length() && memcmp(span.start, key.data(), key.length()) == 0;
 }
 
-void ModelBuilder::loadPlayerWallRow(std::shared_ptr<Player> player, int row, string tileList) {
-    for (unsigned int i = 0; i != tileList.length(); ++i) {
-        TileColour tileColour = getTileColourFromChar(tileList[i]);
-        player->getBoard()->getMosaic().add(make_unique<Tile>(tileColour), row, i);
+void ModelBuilder::loadTileBag(string& tileList) {
+    shared_ptr<TileBag> tileBag = gameModel.getTileBag();
+
+    for (char colourCode : tileList) {
+        tileBag->add(getTileColourFromChar(colourCode));
     }
 }
 
-void ModelBuilder::loadFirstKey(std::string tileList)
-{
+void ModelBuilder::loadBoxLid(string& tileList) {
+    shared_ptr<BoxLid> lid = gameModel.getBoxLid();
+
     for (char colourCode : tileList) {
-        TileColour tileColour = getTileColourFromChar(colourCode);
-        if (tileColour == FIRST) { 
-            gameModel.placeFirstOnTable(make_unique<Tile>(tileColour)); 
-        }
-    }
+        lid->add(getTileColourFromChar(colourCode));
+    } 
 }
 
 // This method should probably be somewhere else
@@ -210,6 +294,81 @@ TileColour ModelBuilder::getTileColourFromChar(char colourCode) {
     return result;
 }
 
+void ModelBuilder::loadState(const GameState& state) {
+    // Build any structure the model is missing
+    while (gameModel.getNumberOfPlayers() < state.numberOfPlayers) {
+        gameModel.addPlayer(make_shared<Player>("Player " + std::to_string(gameModel.getNumberOfPlayers() + 1)));
+    }
+
+    while (gameModel.getNumberOfFactories() < state.numberOfFactories) {
+        gameModel.addFactory(make_shared<Factory>());
+    }
+
+    while (gameModel.getNumberOfCentreFactories() < state.numberOfCentres) {
+        gameModel.addTableCentre();
+    }
+
+    shared_ptr<TileBag> tileBag = gameModel.getTileBag();
+    tileBag->clear();
+    for (unsigned int i = 0; i != state.bag.length; ++i) {
+        tileBag->add(state.bag.get(i));
+    }
+
+    shared_ptr<BoxLid> lid = gameModel.getBoxLid();
+    lid->clear();
+    for (unsigned int i = 0; i != state.lid.length; ++i) {
+        lid->add(state.lid.get(i));
+    }
+
+    for (unsigned int i = 0; i != state.numberOfFactories; ++i) {
+        shared_ptr<Factory> factory = gameModel.getFactory(i);
+        factory->clear();
+
+        for (unsigned int colour = 0; colour != NUMBER_OF_COLOURS; ++colour) {
+            factory->add((TileColour) colour, state.getFactoryCount(i, (TileColour) colour));
+        }
+    }
+
+    for (unsigned int i = 0; i != state.numberOfCentres; ++i) {
+        shared_ptr<Factory> centre = gameModel.getTableCentre(i);
+        centre->clear();
+
+        for (unsigned int colour = 0; colour != NUMBER_OF_COLOURS; ++colour) {
+            centre->add((TileColour) colour, state.centres[i][colour]);
+        }
+    }
+
+    for (unsigned int playerId = 0; playerId != state.numberOfPlayers; ++playerId) {
+        const PlayerState& playerState = state.players[playerId];
+        shared_ptr<Player> player = gameModel.getAllPlayers()[playerId];
+        shared_ptr<PlayerBoard> board = player->getBoard();
+
+        player->setScore(playerState.score);
+        board->getMosaic().setWall(playerState.wall);
+
+        for (int row = 0; row != 5; ++row) {
+            shared_ptr<PatternLine> line = board->getPatternLine(row);
+            line->clear();
+            line->addTiles((TileColour) playerState.lineColour[row], playerState.lineCount[row]);
+        }
+
+        shared_ptr<FloorLine> floorLine = board->getFloorLine();
+        floorLine->clear();
+        for (unsigned int i = 0; i != playerState.floorCount; ++i) {
+            floorLine->addTile((TileColour) playerState.floor[i]);
+        }
+    }
+
+    gameModel.setFirstOnTable(state.firstOnTable);
+
+    if (state.currentPlayer < state.numberOfPlayers) {
+        gameModel.setCurrentPlayer(gameModel.getAllPlayers()[state.currentPlayer]);
+    }
+
+    gameModel.refreshHash();
+    gameModel.refreshLedger();
+}
+
 // If expanded to support more players should have an array of player names and
 // the amount of players in the constructor instead
 bool ModelBuilder::createNewGame(int numberOfCentreFactories, std::string * playerNames, int numberOfPlayers, int seed) {
@@ -224,7 +383,7 @@ bool ModelBuilder::createNewGame(int numberOfCentreFactories, std::string * play
         gameModel.addTableCentre();
     }
     
-    gameModel.placeFirstOnTable(std::make_unique<Tile>(FIRST));
+    gameModel.setFirstOnTable(true);
         
     int numberOfFactories = 5;
     if(numberOfPlayers == 3)
@@ -268,7 +427,7 @@ bool ModelBuilder::createNewGame(int numberOfCentreFactories, std::string * play
         if (randomNumber == 0) {
             // Add dark blue tiles
             if (dark_blue < 20) {
-                tileBag->add(std::make_unique<Tile>(DARK_BLUE));
+                tileBag->add(DARK_BLUE);
                 ++dark_blue;
                 ++tilecount;
             } else {
@@ -280,7 +439,7 @@ bool ModelBuilder::createNewGame(int numberOfCentreFactories, std::string * play
         if (randomNumber == 1) {
             // Add red tiles
             if (red < 20) {
-                tileBag->add(std::make_unique<Tile>(RED));
+                tileBag->add(RED);
                 ++red;
                 ++tilecount;
             } else {
@@ -292,7 +451,7 @@ bool ModelBuilder::createNewGame(int numberOfCentreFactories, std::string * play
         if (randomNumber == 2) {
             // Add yellow tiles
             if (yellow < 20) {
-                tileBag->add(std::make_unique<Tile>(YELLOW));
+                tileBag->add(YELLOW);
                 ++yellow;
                 ++tilecount;
             } else {
@@ -304,7 +463,7 @@ bool ModelBuilder::createNewGame(int numberOfCentreFactories, std::string * play
         if (randomNumber == 3) {
             // Add black tiles
             if (black < 20) {
-                tileBag->add(std::make_unique<Tile>(BLACK));
+                tileBag->add(BLACK);
                 ++black;
                 ++tilecount;
             } else {
@@ -315,11 +474,14 @@ bool ModelBuilder::createNewGame(int numberOfCentreFactories, std::string * play
 
         if (randomNumber == 4 && light_blue < 20) {
             // Add light blue tiles
-            tileBag->add(std::make_unique<Tile>(LIGHT_BLUE));
+            tileBag->add(LIGHT_BLUE);
             ++light_blue;
             ++tilecount;
         }
     }
 
+    gameModel.refreshHash();
+    gameModel.refreshLedger();
+
     return true;
 }
@@ -10,12 +10,13 @@
 #ifndef MODEL_BUILDER_H
 #define MODEL_BUILDER_H
 
-#include <map>
+#include <cstddef>
 #include <memory>
 #include <string>
 
 #include "Factory.h"
 #include "GameModel.h"
+#include "GameState.h"
 #include "Player.h"
 #include "Types.h"
 
@@ -23,50 +24,63 @@ class ModelBuilder {
     public:
         ModelBuilder(GameModel& gameModel);
 
-        // Parse a map of key/value pairs, as would appear in a save game file
-        void loadSaveData(std::map<std::string, std::string>& rawData);
+        // Parse the text of a save game file in a single pass, reading keys
+        // and values in place. Returns false if a line is not a key/value
+        // pair, a key names a player, factory or row out of range, or
+        // players or factories are missing. The model must be new, and still
+        // needs validating.
+        bool loadSaveText(const char* text, size_t length);
+
+        // Load a save game file in either the text or the compact format,
+        // returning false if it cannot be read or the game does not
+        // validate
+        bool loadSaveFile(const std::string& fileName);
 
         // Parse a string of tiles from a saved game and put them in the tilebag
         void loadTileBag(std::string& tileList);
 
         void loadBoxLid(std::string& tileList);
 
+        // Restore a flat snapshot into the model. The model must either be
+        // new, or already have the same number of players, factories and
+        // centres as the snapshot. Players created here get default names.
+        void loadState(const GameState& state);
+
         bool createNewGame(int numberOfCentreFactories, std::string * playerNames, int numberOfPlayers, int seed);
 
     private:
         GameModel& gameModel;
 
-        // Cache the factory data 
-        std::map<int, std::shared_ptr<Factory>> tempFactories;
+        // A run of characters in a buffer being parsed
+        struct TextSpan {
+            const char* start;
+            size_t length;
+        };
 
-        // Cache the player data as it is read in in pieces
-        std::map<std::string, std::shared_ptr<Player>> tempPlayers;
+        // Cache the player and factory data as it is read in in pieces
+        std::shared_ptr<Player> tempPlayers[MAX_STATE_PLAYERS];
+        std::shared_ptr<Factory> tempFactories[MAX_STATE_FACTORIES];
 
         // Cache the id of the current player
-        std::string currentPlayerId;
-        
-        void parseAndLoadDataPair(std::string key, std::string value);
-        TileColour getTileColourFromChar(char colour);
+        int currentPlayerId = -1;
 
-        // Parse and load data into a factory
-        void loadFactory(std::string key, std::string tileList);
-
-        // Parse and load player data from save file
-        void loadPlayerDataPair(std::string key, std::string value);
+        TileColour getTileColourFromChar(char colour);
 
-        // Parse and load a single pattern line for a player
-        void loadPlayerPatternLine(std::shared_ptr<Player> player, int row, std::string tileList);
+        // Load a single key/value pair of a save game's text
+        bool loadTextPair(TextSpan key, TextSpan value);
+        bool loadTextPlayerPair(TextSpan key, TextSpan value);
 
-        // Parse and load a floor line for a player
-        void loadPlayerFloorLine(std::shared_ptr<Player> player, std::string tileList);
+        // Add the tiles in a value to a factory, centre, bag or lid
+        template <typename Container>
+        void loadTextTiles(Container& container, TextSpan value);
 
-        // Parse and load a row of the wall for a player
-        void loadPlayerWallRow(std::shared_ptr<Player> player, int row, std::string tileList);
+        // If the span starts with the prefix, step past it and return true
+        static bool takePrefix(TextSpan& span, const std::string& prefix);
 
-        //
-        void loadFirstKey(std::string value);
+        // If the span starts with digits, step past them and return true
+        static bool takeNumber(TextSpan& span, int& number);
 
-        int numberOfCentreFactories = 0;
+        static bool isKey(TextSpan span, const std::string& key);
 };
 
 #endif // MODEL_BUILDER_H
@@ -1,5 +1,5 @@
-
 #include <memory>
+#include <string>
 
 #include "Mosaic.h"
 #include "Types.h"
@@ -9,253 +9,265 @@ using std::move;
 using std::string;
 using std::unique_ptr;
 
-Mosaic::Mosaic() {
-    initialiseWall();
-    buildTemplate();
-}
-
-void Mosaic::initialiseWall() {
-    wall = new unique_ptr<Tile>*[5];
-
-    for (int i = 0; i != 5; ++i) {
-        wall[i] = new unique_ptr<Tile>[5];
-        for (int j = 0; j != 5; ++j) {
-            wall[i][j] = nullptr;
+// Initialise static member
+const TileColour Mosaic::wallTemplate[5][5] = {
+    {DARK_BLUE, YELLOW, RED, BLACK, LIGHT_BLUE},
+    {LIGHT_BLUE, DARK_BLUE, YELLOW, RED, BLACK},
+    {BLACK, LIGHT_BLUE, DARK_BLUE, YELLOW, RED},
+    {RED, BLACK, LIGHT_BLUE, DARK_BLUE, YELLOW},
+    {YELLOW, RED, BLACK, LIGHT_BLUE, DARK_BLUE}
+};
+
+constexpr unsigned int Mosaic::buildColourMask(TileColour colour) {
+    unsigned int mask = 0;
+
+    for (int space = 0; space != 25; ++space) {
+        if (wallTemplate[space / 5][space % 5] == colour) {
+            mask |= 1u << space;
         }
     }
+
+    return mask;
 }
 
-void Mosaic::buildTemplate() {
-    for (int i = 0; i != 5; ++i) {
-        wallTemplate[i] = new TileColour[5];
+// Built from the template while compiling
+const unsigned int Mosaic::colourMasks[NUMBER_OF_COLOURS] = {
+    buildColourMask(DARK_BLUE),
+    buildColourMask(RED),
+    buildColourMask(YELLOW),
+    buildColourMask(BLACK),
+    buildColourMask(LIGHT_BLUE)
+};
+
+// Placement score for every space, and every occupancy of its row and
+// column. Occupancy bits are numbered along the line, so bit 0 of the row is
+// column 0 and bit 0 of the column is row 0.
+struct PlacementTable {
+    unsigned char scores[25][32][32];
+};
+
+// Length of the unbroken run of set bits next to position, stepping by step
+constexpr int runLength(unsigned int line, int position, int step) {
+    int length = 0;
+    int next = position + step;
+
+    while (next >= 0 && next < 5 && ((line >> next) & 1u)) {
+        ++length;
+        next += step;
     }
-    
-    wallTemplate[0][0] = DARK_BLUE;
-    wallTemplate[0][1] = YELLOW;
-    wallTemplate[0][2] = RED;
-    wallTemplate[0][3] = BLACK;
-    wallTemplate[0][4] = LIGHT_BLUE;
-    wallTemplate[1][0] = LIGHT_BLUE;
-    wallTemplate[1][1] = DARK_BLUE;
-    wallTemplate[1][2] = YELLOW;
-    wallTemplate[1][3] = RED;
-    wallTemplate[1][4] = BLACK;
-    wallTemplate[2][0] = BLACK;
-    wallTemplate[2][1] = LIGHT_BLUE;
-    wallTemplate[2][2] = DARK_BLUE;
-    wallTemplate[2][3] = YELLOW;
-    wallTemplate[2][4] = RED;
-    wallTemplate[3][0] = RED;
-    wallTemplate[3][1] = BLACK;
-    wallTemplate[3][2] = LIGHT_BLUE;
-    wallTemplate[3][3] = DARK_BLUE;
-    wallTemplate[3][4] = YELLOW;
-    wallTemplate[4][0] = YELLOW;
-    wallTemplate[4][1] = RED;
-    wallTemplate[4][2] = BLACK;
-    wallTemplate[4][3] = LIGHT_BLUE;
-    wallTemplate[4][4] = DARK_BLUE;
+
+    return length;
 }
 
-Mosaic::~Mosaic() {
-    for(int i = 0; i < 5; ++i) {
-        for(int j = 0; j < 5; ++j) {
-            wall[i][j] = nullptr;
+constexpr PlacementTable buildPlacementTable() {
+    PlacementTable table = {};
+
+    for (int space = 0; space != 25; ++space) {
+        int row = space / 5;
+        int column = space % 5;
+
+        for (unsigned int rowBits = 0; rowBits != 32; ++rowBits) {
+            int horizontal = runLength(rowBits, column, -1) + runLength(rowBits, column, 1);
+
+            for (unsigned int columnBits = 0; columnBits != 32; ++columnBits) {
+                int vertical = runLength(columnBits, row, -1) + runLength(columnBits, row, 1);
+                int score = horizontal + vertical + 1;
+
+                // Double dip the new tile if a row and a column was formed
+                if (horizontal > 0 && vertical > 0) {
+                    score += 1;
+                }
+
+                table.scores[space][rowBits][columnBits] = score;
+            }
         }
     }
+
+    return table;
 }
 
+constexpr PlacementTable placementTable = buildPlacementTable();
+
+Mosaic::Mosaic() :
+    wall(0)
+{}
+
+Mosaic::~Mosaic() {}
+
 int Mosaic::add(unique_ptr<Tile> tile, int row) {
-    int score = 0;
-    int column = 0;
+    return add(tile->getColour(), row);
+}
 
-    while (column != 5 && score == 0) {
-        if (wallTemplate[row][column] == tile->getColour()) {
-            score = add(move(tile), row, column);
-        }
+int Mosaic::add(TileColour colour, int row) {
+    int score = 0;
+    int column = getColumn(colour, row);
 
-        ++column;
+    if (column != -1) {
+        wall |= 1u << (row * 5 + column);
+        score = calculateScore(row, column);
     }
 
     return score;
 }
 
 int Mosaic::add(unique_ptr<Tile> tile, int row, int column) {
-    wall[row][column] = move(tile);
+    // Empty spaces, as read from a save file, leave the wall untouched
+    if (!tile->isEmpty()) {
+        wall |= 1u << (row * 5 + column);
+    }
 
     return calculateScore(row, column);
 }
 
 int Mosaic::calculateScore(int row, int column) {
-    int rowScore = tilesAbove(row, column) + tilesBelow(row, column);
-    int colScore = tilesLeft(row, column) + tilesRight(row, column);
-
-    int score = rowScore + colScore + 1;
-
-    if (rowScore > 0 && colScore > 0) {
-        // Double dip the new tile if a row and a column was formed
-        score += 1;
-    }
+    return placementTable.scores[row * 5 + column][(wall >> (row * 5)) & MOSAIC_ROW_MASK][columnBits(column)];
+}
 
-    return score;
+unsigned int Mosaic::columnBits(int column) {
+    // Bits 0, 5, 10, 15 and 20 are multiplied onto bits 16 to 20 without
+    // overlapping, which packs the column into 5 consecutive bits
+    return ((((wall >> column) & MOSAIC_COLUMN_MASK) * 0x11111u) >> 16) & 0x1Fu;
 }
 
-int Mosaic::tilesAbove(int row, int column) {
-    int count  = 0;
-    int index = row - 1;
+int Mosaic::runBelow(unsigned int line, int position) {
+    int count = 0;
 
-    while (index != -1 && wall[index][column] != nullptr) {
-        if (!wall[index][column]->isEmpty()) {
-            // if this space contains a non-empty tile, count it 
-            ++count;
-        } else {
-            // force loop exit
-            index = 0;
-        }
-        
-        --index;
+    if (position != 0) {
+        // Move the bit below position to the top of the word, then count
+        // leading ones
+        count = __builtin_clz(~(line << (32 - position)));
     }
 
     return count;
 }
 
-int Mosaic::tilesBelow(int row, int column) {
-    int count = 0;
-    int index = row + 1;
+int Mosaic::runAbove(unsigned int line, int position) {
+    // Bits past the end of the line are zero, so the inverse always ends
+    return __builtin_ctz(~(line >> (position + 1)));
+}
 
-    while (index != 5 && wall[index][column] != nullptr) {
-        if (!wall[index][column]->isEmpty()) {
-            // if this space contains a non-empty tile, count it 
-            ++count;
-        } else {
-            // force loop exit
-            index = 4;
-        }
-        
-        ++index;
-    }
+int Mosaic::tilesAbove(int row, int column) {
+    return runBelow(columnBits(column), row);
+}
 
-    return count;
+int Mosaic::tilesBelow(int row, int column) {
+    return runAbove(columnBits(column), row);
 }
 
 int Mosaic::tilesLeft(int row, int column) {
-    int count  = 0;
-    int index = column - 1;
+    return runBelow((wall >> (row * 5)) & MOSAIC_ROW_MASK, column);
+}
 
-    while (index != -1 && wall[row][index] != nullptr) {
-        if (!wall[row][index]->isEmpty()) {
-            // if this space contains a non-empty tile, count it 
-            ++count;
-        } else {
-            // force loop exit
-            index = 0;
-        }
+int Mosaic::tilesRight(int row, int column) {
+    return runAbove((wall >> (row * 5)) & MOSAIC_ROW_MASK, column);
+}
 
-        --index;
-    }
+bool Mosaic::columnCompleted(int column) {
+    unsigned int columnMask = MOSAIC_COLUMN_MASK << column;
 
-    return count;
+    return (wall & columnMask) == columnMask;
 }
 
-int Mosaic::tilesRight(int row, int column) {
-    int count = 0;
-    int index = column + 1;
+bool Mosaic::rowComplete() {
+    return getCompletedRows() != 0;
+}
 
-    while (index != 5 && wall[row][index] != nullptr) {
-        if (!wall[row][index]->isEmpty()) {
-            // if this space contains a non-empty tile, count it 
-            ++count;
-        } else {
-            // force loop exit
-            index = 4;
-        }
+bool Mosaic::rowComplete(int row) {
+    return ((wall >> (row * 5)) & MOSAIC_ROW_MASK) == MOSAIC_ROW_MASK;
+}
 
-        ++index;
-    }
+int Mosaic::getCompletedRows() {
+    // A bit survives at the start of each row only if all 5 of the row do
+    unsigned int full = wall & (wall >> 1) & (wall >> 2) & (wall >> 3) & (wall >> 4);
 
-    return count;
+    return __builtin_popcount(full & MOSAIC_COLUMN_MASK);
 }
 
-bool Mosaic::columnCompleted(int column) {
-    bool completed = true;
-    int index = 0;
-
-    // Assume complete, until we hit nullptr or empty tile
-    while (index != 5 && completed) {
-        if (wall[index][column] == nullptr) {
-            completed = false;
-        } else if (wall[index][column]->isEmpty()) {
-            completed = false;
-        }
+int Mosaic::getCompletedColumns() {
+    // Likewise for the top of each column
+    unsigned int full = wall & (wall >> 5) & (wall >> 10) & (wall >> 15) & (wall >> 20);
 
-        ++index;
+    return __builtin_popcount(full & MOSAIC_ROW_MASK);
+}
+
+int Mosaic::getCompletedColours() {
+    int completed = 0;
+
+    for (int colour = 0; colour != NUMBER_OF_COLOURS; ++colour) {
+        if ((wall & colourMasks[colour]) == colourMasks[colour]) {
+            ++completed;
+        }
     }
 
     return completed;
 }
 
-bool Mosaic::rowComplete() {
-    bool completed = false;
-    int index = 0;
+bool Mosaic::inRow(TileColour colour, int row) {
+    bool inRow = false;
+    int column = getColumn(colour, row);
 
-    while (index != 5 && !completed) {
-        completed = rowComplete(index);
-        ++index;
+    if (column != -1) {
+        inRow = (wall >> (row * 5 + column)) & 1u;
     }
 
-    return completed;
+    return inRow;
 }
 
-bool Mosaic::rowComplete(int row) {
-    bool completed = true;
-    int index = 0;
-
-    // Assume complete, until we hit nullptr or empty tile
-    while (index != 5 && completed) {
-        if (wall[row][index] == nullptr) {
-            completed = false;
-        } else if (wall[row][index]->isEmpty()) {
-            completed = false;
-        }
+void Mosaic::reportTileCounts(std::map<TileColour, int>& tileCounts) {
+    for (int colour = DARK_BLUE; colour != FIRST; ++colour) {
+        int count = __builtin_popcount(wall & colourMasks[colour]);
 
-        ++index;
+        if (count != 0) {
+            tileCounts[(TileColour) colour] += count;
+        }
     }
+}
 
-    return completed;
+unsigned int Mosaic::getWall() {
+    return wall;
 }
 
-bool Mosaic::inRow(TileColour colour, int row) {
-    bool inRow = false;
-    int index = 0;
+void Mosaic::setWall(unsigned int wall) {
+    this->wall = wall & MOSAIC_FULL_MASK;
+}
 
-    while (index != 5 && !inRow) {
-        if (wall[row][index] != nullptr) {
-            if(wall[row][index]->getColour() == colour) {
-                inRow = true;
-            }
+unsigned int Mosaic::getRowColours(int row) {
+    unsigned int colours = 0;
+    unsigned int line = (wall >> (row * 5)) & MOSAIC_ROW_MASK;
+
+    for (int column = 0; column != 5; ++column) {
+        if ((line >> column) & 1u) {
+            colours |= 1u << wallTemplate[row][column];
         }
-        
-        ++index;
     }
 
-    return  inRow;
+    return colours;
 }
 
-void Mosaic::reportTileCounts(std::map<TileColour, int>& tileCounts) {
-    for (int row = 0; row != 5; ++row) {
-        for (int col = 0; col != 5; ++col) {
-            if (wall[row][col] != nullptr) {
-                int newCount = 1;
-                auto count = tileCounts.find(wall[row][col]->getColour());
-                
-                if (count != tileCounts.end()) {
-                    newCount = count->second + 1;
-                } 
-
-                tileCounts[wall[row][col]->getColour()] = newCount;
-            }
+int Mosaic::getColumn(TileColour colour, int row) {
+    int column = -1;
+
+    for (int i = 0; i != 5 && column == -1; ++i) {
+        if (wallTemplate[row][i] == colour) {
+            column = i;
         }
     }
+
+    return column;
+}
+
+TileColour Mosaic::getTemplateColour(int row, int column) {
+    return wallTemplate[row][column];
+}
+
+unsigned int Mosaic::getColourMask(TileColour colour) {
+    unsigned int mask = 0;
+
+    if (colour < NUMBER_OF_COLOURS) {
+        mask = colourMasks[colour];
+    }
+
+    return mask;
 }
 
 string Mosaic::toString(int row) {
@@ -266,47 +278,34 @@ string Mosaic::toString(int row, bool useWallTemplate) {
     string result = "";
 
     for (int i = 0; i != 5; ++i) {
-        if(useWallTemplate) {
+        if (useWallTemplate || (wall >> (row * 5 + i)) & 1u) {
             result += Tile::toString(wallTemplate[row][i]);
         } else {
-            if (wall[row][i] != nullptr) {
-                result += wall[row][i]->toString();
-            } else {
-                result += Tile::toString(NONE);
-            }
-            
+            result += Tile::toString(NONE);
         }
     }
 
     return result;
 }
 
-string Mosaic::getPrintable(int row)
+void Mosaic::print(OutputFrame& frame, int row)
 {
-    string result = "";
-
-
-
     for(int col = 0; col < 5; ++col)
     {
-        if(wall[row][col] != nullptr)
+        if((wall >> (row * 5 + col)) & 1u)
         {
-            result += wall[row][col]->colouredToString();
+            frame.addTile(wallTemplate[row][col]);
         }
         else
         {
-            result += Tile::colouredToString(NONE);
+            frame.addTile(NONE);
         }
-        
-        
     }
 
-    result += " <-> ";
+    frame.add(" <-> ");
 
     for(int col = 0; col < 5; ++col)
     {
-        result += Tile::colouredToString(wallTemplate[row][col]);
+        frame.addTile(wallTemplate[row][col]);
     }
-
-    return result;
 }
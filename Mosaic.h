@@ -1,17 +1,32 @@
-
 /*
  * Mosaic
- * 
+ *
+ * The wall is stored as a 25 bit occupancy mask, with bit (row * 5 + column)
+ * set when that space holds a tile. The colour of a space is fixed by the wall
+ * template, so the mask is all that is needed to describe a player's wall.
+ *
+ * Placement scores come from a table built at compile time, indexed by the
+ * space and the occupancy of its row and column, so scoring a tile is a
+ * single lookup. End of game bonuses are counted with bit operations.
+ *
  * Authors: C. Hodgen (s3031209), J. Osrecak (s3782455)
  */
 
 #ifndef MOSAIC_H
 #define MOSAIC_H
 
+#include <map>
 #include <memory>
+#include <string>
 
+#include "OutputFrame.h"
 #include "Tile.h"
 
+// Bits of the wall mask covering row 0 and column 0 respectively
+#define MOSAIC_ROW_MASK     0x1Fu
+#define MOSAIC_COLUMN_MASK  0x108421u
+#define MOSAIC_FULL_MASK    0x1FFFFFFu
+
 class Mosaic
 {
     public:
@@ -24,6 +39,10 @@ class Mosaic
         // Adds tile to wall and returns the number of points sccored
         int add(std::unique_ptr<Tile> tile, int row, int column);
 
+        // Places a tile of the given colour in its template position for the
+        // row, and returns the score
+        int add(TileColour colour, int row);
+
         // Returns true if given column is completed
         bool columnCompleted(int column);
 
@@ -33,12 +52,14 @@ class Mosaic
         // Returns true is specified row is completed
         bool rowComplete(int row);
 
+        // Number of complete rows, columns, and colours with all 5 tiles
+        int getCompletedRows();
+        int getCompletedColumns();
+        int getCompletedColours();
+
         // Returns true if colour is in row
         bool inRow(TileColour colour, int row);
 
-        // Builds the template array
-        void buildTemplate();
-
         // Calculate the score for a tile placed at row, column
         int calculateScore(int row, int column);
 
@@ -57,22 +78,54 @@ class Mosaic
         // Provide a breakdown of the tiles on the wall
         void reportTileCounts(std::map<TileColour, int>& tileCounts);
 
+        // Get the occupancy mask of the wall
+        unsigned int getWall();
+
+        // Replace the occupancy mask of the wall
+        void setWall(unsigned int wall);
+
+        // Get a 5 bit mask of the colours already placed in a row
+        unsigned int getRowColours(int row);
+
         // Get a printable string for the given row
         std::string toString(int row);
 
         // Get a printable string for the given row of the mosaic template
         std::string toString(int row, bool useWallTemplate);
 
-        std::string getPrintable(int row);
+        // Add a row of the wall to a screen, followed by the template
+        void print(OutputFrame& frame, int row);
+
+        // Column in which the colour belongs for the given row
+        static int getColumn(TileColour colour, int row);
+
+        // Colour of the template at row, column
+        static TileColour getTemplateColour(int row, int column);
+
+        // Mask of every space on the wall reserved for the colour
+        static unsigned int getColourMask(TileColour colour);
 
     private:
-        void initialiseWall();
+        // Returns the 5 bits of the given column, with row 0 in bit 0
+        unsigned int columnBits(int column);
+
+        // Counts the unbroken run of set bits below position in a 5 bit line
+        static int runBelow(unsigned int line, int position);
+
+        // Counts the unbroken run of set bits above position in a 5 bit line
+        static int runAbove(unsigned int line, int position);
 
         // Player's tiles, as they have chosen to place them on their wall
-        std::unique_ptr<Tile>** wall;
+        unsigned int wall;
 
         // Matrix of which tiles go in which position on the wall
-        TileColour** wallTemplate = new TileColour*[5];
+        static const TileColour wallTemplate[5][5];
+
+        // Spaces reserved for each colour, by colour
+        static const unsigned int colourMasks[NUMBER_OF_COLOURS];
+
+        // Mask of the spaces for a colour, worked out from the template
+        static constexpr unsigned int buildColourMask(TileColour colour);
 };
 
 #endif // MOSAIC_H
@@ -0,0 +1,160 @@
+#include <string>
+
+#include "GameModel.h"
+#include "Move.h"
+#include "Tile.h"
+
+using std::string;
+using std::to_string;
+
+Move::Move() :
+    value(MOVE_NONE)
+{}
+
+Move::Move(uint16_t value) :
+    value(value)
+{}
+
+Move::Move(int source, TileColour colour, int destination, int dumpCentre) :
+    value((source & 0xF) | ((colour & 0x7) << 4) | ((destination & 0x7) << 7) |
+          ((dumpCentre & 0x1) << 10))
+{}
+
+int Move::getSource() const {
+    return value & 0xF;
+}
+
+TileColour Move::getColour() const {
+    return (TileColour) ((value >> 4) & 0x7);
+}
+
+int Move::getDestination() const {
+    return (value >> 7) & 0x7;
+}
+
+int Move::getDumpCentre() const {
+    return (value >> 10) & 0x1;
+}
+
+uint16_t Move::getValue() const {
+    return value;
+}
+
+bool Move::isValid() const {
+    return value != MOVE_NONE;
+}
+
+bool Move::operator==(const Move& other) const {
+    return value == other.value;
+}
+
+bool Move::operator!=(const Move& other) const {
+    return value != other.value;
+}
+
+string Move::toString(bool withDumpCentre) const {
+    string result = "";
+
+    if (getSource() >= CENTRE_SLOT_OFFSET) {
+        result += getSource() == CENTRE_SLOT_OFFSET ? "C" : "D";
+    } else {
+        result += to_string(getSource() + 1);
+    }
+
+    result += " " + Tile::toString(getColour()) + " ";
+
+    if (getDestination() == MOVE_FLOOR_LINE) {
+        result += "F";
+    } else {
+        result += to_string(getDestination() + 1);
+    }
+
+    if (withDumpCentre) {
+        result += getDumpCentre() == 0 ? " C" : " D";
+    }
+
+    return result;
+}
+
+Move Move::parse(const string& input, bool& dumpGiven) {
+    Move move;
+    dumpGiven = false;
+
+    /* valid formats: "{1} {2} {3}" or "{1} {2} {3} {4}"
+    *   {1} = {'c', 'C', 'd', 'D', 1, 2, 3, 4, 5, 6, 7, 8, 9}
+    *   {2} = {'R', 'Y', 'B', 'L', 'U'}
+    *   {3} = {'F', 1, 2, 3, 4, 5}
+    *   {4} = {'c', 'C', 'd', 'D'}
+    */
+    if (input.size() >= 5) {
+        int source = parseSource(input[0]);
+        TileColour colour = parseColour(input[2]);
+        int destination = parseDestination(input[4]);
+        int dumpCentre = 0;
+
+        if (input.size() >= 7 && parseCentre(input[6]) != -1) {
+            dumpCentre = parseCentre(input[6]);
+            dumpGiven = true;
+        }
+
+        if (source != -1 && colour != NONE && destination != -1) {
+            move = Move(source, colour, destination, dumpCentre);
+        }
+    }
+
+    return move;
+}
+
+int Move::parseSource(char sourceKey) {
+    int source = parseCentre(sourceKey);
+
+    if (source != -1) {
+        source += CENTRE_SLOT_OFFSET;
+    } else if (sourceKey >= '1' && sourceKey <= '9') {
+        source = sourceKey - '1';
+    }
+
+    return source;
+}
+
+int Move::parseDestination(char destKey) {
+    int dest = -1;
+
+    if (destKey == 'f' || destKey == 'F') {
+        dest = MOVE_FLOOR_LINE;
+    } else if (destKey >= '1' && destKey <= '5') {
+        dest = destKey - '1';
+    }
+
+    return dest;
+}
+
+TileColour Move::parseColour(char colourKey) {
+    TileColour colour = NONE;
+
+    if (colourKey == 'R' || colourKey == 'r' ) {
+        colour = RED;
+    } else if (colourKey == 'Y' || colourKey == 'y' ) {
+        colour = YELLOW;
+    } else if (colourKey == 'B' || colourKey == 'b' ) {
+        colour = DARK_BLUE;
+    } else if (colourKey == 'L' || colourKey == 'l' ) {
+        colour = LIGHT_BLUE;
+    } else if (colourKey == 'U' || colourKey == 'u' ) {
+        colour = BLACK;
+    }
+
+    return colour;
+}
+
+int Move::parseCentre(char centreKey) {
+    int centre = -1;
+
+    if (centreKey == 'c' || centreKey == 'C') {
+        centre = 0;
+    } else if (centreKey == 'd' || centreKey == 'D') {
+        centre = 1;
+    }
+
+    return centre;
+}
@@ -0,0 +1,86 @@
+/*
+ * Move
+ * 
+ * A turn packed into 16 bits: the source factory or centre, the colour to
+ * take, the destination line, and which centre receives any leftover tiles.
+ * 
+ *   bits 0-3   source slot (factories 0-8, centres from CENTRE_SLOT_OFFSET)
+ *   bits 4-6   colour
+ *   bits 7-9   destination (pattern lines 0-4, MOVE_FLOOR_LINE)
+ *   bit  10    centre that leftover tiles are dumped into
+ * 
+ * Authors: C. Hodgen (s3031209), J. Osrecak (s3782455)
+ */
+
+#ifndef MOVE_H
+#define MOVE_H
+
+#include <cstdint>
+#include <string>
+
+#include "Types.h"
+
+// Destination value for the floor line
+#define MOVE_FLOOR_LINE 5
+
+// Value of a move that does nothing, used to mark "no move"
+#define MOVE_NONE       0xFFFF
+
+class Move {
+    public:
+        // Creates the "no move" value
+        Move();
+
+        // Rebuild a move from its packed value
+        explicit Move(uint16_t value);
+
+        Move(int source, TileColour colour, int destination, int dumpCentre);
+
+        // Source slot of the tiles
+        int getSource() const;
+
+        // Colour of tiles to take
+        TileColour getColour() const;
+
+        // Pattern line 0-4, or MOVE_FLOOR_LINE
+        int getDestination() const;
+
+        // Index of the centre that receives leftover tiles
+        int getDumpCentre() const;
+
+        // Packed 16 bit value
+        uint16_t getValue() const;
+
+        // True unless this is the "no move" value
+        bool isValid() const;
+
+        bool operator==(const Move& other) const;
+        bool operator!=(const Move& other) const;
+
+        // The move as typed by a player e.g. "2 Y 5", followed by the dump
+        // centre ("C" or "D") when withDumpCentre is set
+        std::string toString(bool withDumpCentre) const;
+
+        // Read a move typed as "{source} {colour} {destination} [{centre}]".
+        // Returns the "no move" value if it cannot be read. dumpGiven is set
+        // when the dump centre was typed; otherwise the move dumps into C.
+        // The move is not checked against a position.
+        static Move parse(const std::string& input, bool& dumpGiven);
+
+    private:
+        uint16_t value;
+
+        // Slot for a source key, or -1
+        static int parseSource(char sourceKey);
+
+        // Destination for a destination key, or -1
+        static int parseDestination(char destKey);
+
+        // Colour for a colour key, or NONE
+        static TileColour parseColour(char colourKey);
+
+        // Centre index for a centre key, or -1
+        static int parseCentre(char centreKey);
+};
+
+#endif // MOVE_H
@@ -0,0 +1,168 @@
+#include <algorithm>
+#include <climits>
+#include <memory>
+
+#include "MoveGenerator.h"
+
+using std::shared_ptr;
+
+MoveGenerator::MoveGenerator(GameModel& gameModel) :
+    gameModel(gameModel)
+{}
+
+unsigned int MoveGenerator::generate(Move* moves) {
+    return generateMoves(moves, false);
+}
+
+unsigned int MoveGenerator::generateDistinct(Move* moves) {
+    return generateMoves(moves, true);
+}
+
+unsigned int MoveGenerator::generateMoves(Move* moves, bool distinct) {
+    unsigned int count = 0;
+    shared_ptr<PlayerBoard> board = gameModel.getCurrentPlayer()->getBoard();
+    int numberOfCentres = gameModel.getNumberOfCentreFactories();
+    int numberOfFactories = gameModel.getNumberOfFactories();
+
+    // Colours each pattern line can take, looked up once per position
+    unsigned int acceptMasks[5];
+    for (int row = 0; row != 5; ++row) {
+        acceptMasks[row] = board->getAcceptMask(row);
+    }
+
+    // Contents of every source, to spot repeats
+    unsigned int contents[MAX_STATE_FACTORIES + 2];
+    bool sameCentres = false;
+
+    if (distinct) {
+        for (int i = 0; i != numberOfFactories + numberOfCentres; ++i) {
+            contents[i] = getContents(i >= numberOfFactories ? *gameModel.getTableCentre(i - numberOfFactories)
+                                                             : *gameModel.getFactory(i));
+        }
+
+        // Dumping in either of two identical centres comes to the same thing
+        sameCentres = numberOfCentres == 2 &&
+                      contents[numberOfFactories] == contents[numberOfFactories + 1];
+    }
+
+    for (int i = 0; i != numberOfFactories + numberOfCentres; ++i) {
+        bool isCentre = i >= numberOfFactories;
+        int slot = isCentre ? CENTRE_SLOT_OFFSET + i - numberOfFactories : i;
+        shared_ptr<Factory> source = isCentre ? gameModel.getTableCentre(slot - CENTRE_SLOT_OFFSET)
+                                              : gameModel.getFactory(slot);
+        unsigned int colours = source->getColourMask();
+
+        // Skip a source holding the same tiles as an earlier one of its kind
+        int first = isCentre ? numberOfFactories : 0;
+        for (int j = first; j != i && distinct && colours != 0; ++j) {
+            if (contents[j] == contents[i]) {
+                colours = 0;
+            }
+        }
+
+        while (colours != 0) {
+            TileColour colour = (TileColour) __builtin_ctz(colours);
+            colours &= colours - 1;
+
+            // Only a factory with other colours left over has a real choice
+            // of where to dump them
+            int dumpChoices = 1;
+            if (!isCentre && numberOfCentres == 2 && !sameCentres && source->count(colour) != source->size()) {
+                dumpChoices = 2;
+            }
+
+            for (int destination = 0; destination != MOVE_FLOOR_LINE + 1; ++destination) {
+                if (destination == MOVE_FLOOR_LINE || (acceptMasks[destination] >> colour) & 1u) {
+                    for (int dump = 0; dump != dumpChoices; ++dump) {
+                        moves[count] = Move(slot, colour, destination, dump);
+                        ++count;
+                    }
+                }
+            }
+        }
+    }
+
+    return count;
+}
+
+bool MoveGenerator::isLegal(Move move) {
+    bool legal = false;
+    int slot = move.getSource();
+    TileColour colour = move.getColour();
+    int destination = move.getDestination();
+    shared_ptr<Factory> source = nullptr;
+
+    if (slot < (int) gameModel.getNumberOfFactories()) {
+        source = gameModel.getFactory(slot);
+    } else if (slot >= CENTRE_SLOT_OFFSET && slot - CENTRE_SLOT_OFFSET < gameModel.getNumberOfCentreFactories()) {
+        source = gameModel.getTableCentre(slot - CENTRE_SLOT_OFFSET);
+    }
+
+    if (move.isValid() && source && colour < NUMBER_OF_COLOURS && source->contains(colour) &&
+        move.getDumpCentre() < gameModel.getNumberOfCentreFactories()) {
+        if (destination == MOVE_FLOOR_LINE) {
+            legal = true;
+        } else if (destination < 5) {
+            legal = gameModel.getCurrentPlayer()->getBoard()->canAccept(colour, destination);
+        }
+    }
+
+    return legal;
+}
+
+void MoveGenerator::order(Move* moves, unsigned int numberOfMoves, Move first) {
+    int guesses[MAX_MOVES];
+
+    for (unsigned int i = 0; i != numberOfMoves; ++i) {
+        guesses[i] = moves[i] == first ? INT_MAX : guess(moves[i]);
+    }
+
+    // Insertion sort, best first, keeping the generator's order for ties
+    for (unsigned int i = 1; i < numberOfMoves; ++i) {
+        Move move = moves[i];
+        int value = guesses[i];
+        unsigned int j = i;
+
+        while (j != 0 && guesses[j - 1] < value) {
+            moves[j] = moves[j - 1];
+            guesses[j] = guesses[j - 1];
+            --j;
+        }
+
+        moves[j] = move;
+        guesses[j] = value;
+    }
+}
+
+int MoveGenerator::guess(Move move) {
+    int source = move.getSource();
+    shared_ptr<Factory> factory = source >= CENTRE_SLOT_OFFSET ?
+                                  gameModel.getTableCentre(source - CENTRE_SLOT_OFFSET) :
+                                  gameModel.getFactory(source);
+    int taken = factory->count(move.getColour());
+    int space = 0;
+
+    if (move.getDestination() != MOVE_FLOOR_LINE) {
+        space = gameModel.getCurrentPlayer()->getBoard()->getPatternLine(move.getDestination())->getSpace();
+    }
+
+    int placed = std::min(taken, space);
+    int result = 2 * placed - 3 * (taken - placed);
+
+    // Filling a line scores this round
+    if (space != 0 && taken >= space) {
+        result += 4;
+    }
+
+    return result;
+}
+
+unsigned int MoveGenerator::getContents(Factory& factory) {
+    unsigned int contents = 0;
+
+    for (int colour = 0; colour != NUMBER_OF_COLOURS; ++colour) {
+        contents |= (factory.count((TileColour) colour) & 0x1Fu) << (colour * 5);
+    }
+
+    return contents;
+}
@@ -0,0 +1,62 @@
+/*
+ * Move Generator
+ * 
+ * Lists every legal move for the current player, straight from the game
+ * model, without going through text commands.
+ * 
+ * Authors: C. Hodgen (s3031209), J. Osrecak (s3782455)
+ */
+
+#ifndef MOVE_GENERATOR_H
+#define MOVE_GENERATOR_H
+
+#include "GameModel.h"
+#include "Move.h"
+
+// Upper bound on the moves in any position: 11 sources, 5 colours,
+// 6 destinations and 2 dump centres
+#define MAX_MOVES   660
+
+class MoveGenerator {
+    public:
+        MoveGenerator(GameModel& gameModel);
+
+        // Write every legal move for the current player into moves, which
+        // must have room for MAX_MOVES. Returns the number of moves written.
+        //
+        // Moves from a factory get one entry per centre only when there are
+        // two centres and the factory has leftover tiles to dump; otherwise
+        // the dump centre is always 0.
+        unsigned int generate(Move* moves);
+
+        // As generate, but leaving out moves that lead to the same position
+        // as an earlier move, once the factories, and the centres, are put
+        // in order. Moves from factories holding the same tiles are only
+        // listed for the first of them, and so on. Searches keyed on
+        // GameModel::getCanonicalHash lose nothing by it.
+        unsigned int generateDistinct(Move* moves);
+
+        // Check a single move is legal for the current player
+        bool isLegal(Move move);
+
+        // Sort moves so the most promising are first, starting with first if
+        // it is one of them. Searches cut off sooner when good moves come
+        // early.
+        void order(Move* moves, unsigned int numberOfMoves, Move first);
+
+    private:
+        GameModel& gameModel;
+
+        // Write the legal moves, leaving out repeats if distinct is true
+        unsigned int generateMoves(Move* moves, bool distinct);
+
+        // Colour counts of a factory or centre, 5 bits per colour, so equal
+        // contents give equal values
+        static unsigned int getContents(Factory& factory);
+
+        // Quick guess at how good a move is, without playing it: tiles
+        // placed, lines filled, and tiles that fall to the floor
+        int guess(Move move);
+};
+
+#endif // MOVE_GENERATOR_H
@@ -0,0 +1,141 @@
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "CompactSave.h"
+#include "MoveJournal.h"
+#include "Player.h"
+
+using std::shared_ptr;
+using std::string;
+using std::vector;
+
+MoveJournal::MoveJournal() :
+    file(-1),
+    sinceCheckpoint(0)
+{}
+
+MoveJournal::~MoveJournal() {
+    close();
+}
+
+bool MoveJournal::startFromSeed(GameModel& gameModel, int seed, const string& fileName) {
+    bool started = create(fileName);
+    size_t start = data.size();
+    uint32_t bits = seed;
+
+    writeWord(JOURNAL_SEED);
+    for (int i = 0; i != 4; ++i) {
+        data.push_back((bits >> (i * 8)) & 0xFF);
+    }
+    data.push_back(gameModel.getNumberOfCentreFactories());
+    data.push_back(gameModel.getNumberOfPlayers());
+
+    for (shared_ptr<Player> player : gameModel.getAllPlayers()) {
+        string& name = player->getName();
+
+        if (name.size() > 255) {
+            started = false;
+        }
+        data.push_back(name.size());
+        data.insert(data.end(), name.begin(), name.begin() + std::min<size_t>(name.size(), 255));
+    }
+
+    // Fill in the length now it is known
+    unsigned int length = data.size() - start - 2;
+    started = started && length <= JOURNAL_LENGTH_MASK;
+    data[start] = length & 0xFF;
+    data[start + 1] = (JOURNAL_SEED | length) >> 8;
+
+    started = started && flush();
+    if (!started) {
+        close();
+    }
+
+    return started;
+}
+
+bool MoveJournal::startFromPosition(GameModel& gameModel, const string& fileName) {
+    bool started = create(fileName) && writeCheckpoint(gameModel) && flush();
+
+    if (!started) {
+        close();
+    }
+
+    return started;
+}
+
+bool MoveJournal::record(Move move, GameModel& gameModel) {
+    bool recorded = isOpen();
+
+    if (recorded) {
+        writeWord(move.getValue());
+
+        if (++sinceCheckpoint == JOURNAL_CHECKPOINT_INTERVAL) {
+            // A checkpoint that will not fit is left out, which only makes
+            // the next seek past it slower
+            writeCheckpoint(gameModel);
+        }
+
+        recorded = flush();
+        if (!recorded) {
+            close();
+        }
+    }
+
+    return recorded;
+}
+
+bool MoveJournal::isOpen() {
+    return file != -1;
+}
+
+void MoveJournal::close() {
+    if (file != -1) {
+        ::close(file);
+        file = -1;
+    }
+}
+
+bool MoveJournal::create(const string& fileName) {
+    close();
+    data.clear();
+    sinceCheckpoint = 0;
+
+    file = open(fileName.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_APPEND, 0644);
+
+    data.insert(data.end(), JOURNAL_MAGIC, JOURNAL_MAGIC + 3);
+    data.push_back(JOURNAL_VERSION);
+
+    return isOpen();
+}
+
+void MoveJournal::writeWord(unsigned int word) {
+    data.push_back(word & 0xFF);
+    data.push_back((word >> 8) & 0xFF);
+}
+
+bool MoveJournal::writeCheckpoint(GameModel& gameModel) {
+    vector<uint8_t> checkpoint;
+    bool written = CompactSave::encode(gameModel, checkpoint) && checkpoint.size() <= JOURNAL_LENGTH_MASK;
+
+    if (written) {
+        writeWord(JOURNAL_CHECKPOINT | checkpoint.size());
+        data.insert(data.end(), checkpoint.begin(), checkpoint.end());
+        sinceCheckpoint = 0;
+    }
+
+    return written;
+}
+
+bool MoveJournal::flush() {
+    bool flushed = isOpen() && write(file, data.data(), data.size()) == (ssize_t) data.size();
+    data.clear();
+
+    return flushed;
+}
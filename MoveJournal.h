@@ -0,0 +1,101 @@
+/*
+ * Move Journal
+ * 
+ * An append-only record of a game, written as it is played, from which
+ * JournalReplay can rebuild any position in it. Files start with a 4 byte
+ * header, "AZJ" and a version number, followed by records, each starting
+ * with a 16 bit little endian word:
+ * 
+ *   below 0x8000            a move, as its packed Move value
+ *   0x8000 + n, n bytes     a checkpoint, the position after the moves so
+ *                           far as a compact save
+ *   0xC000 + n, n bytes     the start of a game made by
+ *                           ModelBuilder::createNewGame: the seed (4 bytes),
+ *                           the number of centres and of players (1 each),
+ *                           then each player's name as a length byte and the
+ *                           characters
+ * 
+ * A journal starts with either a seed or a checkpoint, and a checkpoint
+ * follows every JOURNAL_CHECKPOINT_INTERVAL moves, so a position can be
+ * rebuilt without replaying the whole game. Moves take 2 bytes each, and
+ * every record is written with a single write call, so a game cut off part
+ * way through leaves at most one partial record at the end, which is
+ * ignored when it is read back.
+ * 
+ * Authors: C. Hodgen (s3031209), J. Osrecak (s3782455)
+ */
+
+#ifndef MOVE_JOURNAL_H
+#define MOVE_JOURNAL_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "GameModel.h"
+#include "Move.h"
+
+#define JOURNAL_MAGIC               "AZJ"
+#define JOURNAL_VERSION             1
+#define JOURNAL_HEADER              4
+
+// Moves between checkpoints
+#define JOURNAL_CHECKPOINT_INTERVAL 20
+
+// Record tags, in the top two bits of a record's first word. The rest of
+// the word is the length of what follows.
+#define JOURNAL_CHECKPOINT          0x8000
+#define JOURNAL_SEED                0xC000
+#define JOURNAL_TAG_MASK            0xC000
+#define JOURNAL_LENGTH_MASK         0x3FFF
+
+class MoveJournal {
+    public:
+        MoveJournal();
+        ~MoveJournal();
+
+        MoveJournal(const MoveJournal&) = delete;
+        MoveJournal& operator=(const MoveJournal&) = delete;
+
+        // Start a journal, overwriting the file, for a game just made by
+        // ModelBuilder::createNewGame with the seed, before its first move.
+        // Returns false if the file cannot be written.
+        bool startFromSeed(GameModel& gameModel, int seed, const std::string& fileName);
+
+        // Start a journal, overwriting the file, from the position the game
+        // is in now. Returns false if the file cannot be written.
+        bool startFromPosition(GameModel& gameModel, const std::string& fileName);
+
+        // Append a move just played, given the position after it. Returns
+        // false, and closes the journal, if the file cannot be written.
+        bool record(Move move, GameModel& gameModel);
+
+        // True from a successful start until the journal is closed
+        bool isOpen();
+
+        void close();
+
+    private:
+        int file;
+
+        // Moves recorded since the last checkpoint
+        unsigned int sinceCheckpoint;
+
+        // The record being written, kept to reuse its space
+        std::vector<uint8_t> data;
+
+        // Open the file and write the header. Returns false on failure.
+        bool create(const std::string& fileName);
+
+        // Add a record's first word, or a move, to the record being written
+        void writeWord(unsigned int word);
+
+        // Add a checkpoint of the position to the record being written.
+        // Returns false if it will not fit.
+        bool writeCheckpoint(GameModel& gameModel);
+
+        // Write out the record, returning false on failure
+        bool flush();
+};
+
+#endif // MOVE_JOURNAL_H
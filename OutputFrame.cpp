@@ -0,0 +1,84 @@
+#include <string>
+
+#include "OutputFrame.h"
+#include "Tile.h"
+
+using std::string;
+
+OutputFrame::OutputFrame(bool coloured) :
+    coloured(coloured)
+{
+    buffer.reserve(OUTPUT_FRAME_RESERVE);
+}
+
+bool OutputFrame::isColoured() {
+    return coloured;
+}
+
+void OutputFrame::setColoured(bool coloured) {
+    this->coloured = coloured;
+}
+
+void OutputFrame::clear() {
+    buffer.clear();
+}
+
+void OutputFrame::add(const char* text) {
+    buffer += text;
+}
+
+void OutputFrame::add(const string& text) {
+    buffer += text;
+}
+
+void OutputFrame::add(char c) {
+    buffer += c;
+}
+
+void OutputFrame::add(int number) {
+    char digits[12];
+    unsigned int length = 0;
+    unsigned int value = number < 0 ? 0u - (unsigned int) number : number;
+
+    // Written backwards, so no string is made for the number
+    do {
+        digits[length++] = '0' + value % 10;
+        value /= 10;
+    } while (value != 0);
+
+    if (number < 0) {
+        buffer += '-';
+    }
+
+    while (length != 0) {
+        buffer += digits[--length];
+    }
+}
+
+void OutputFrame::addSpaces(unsigned int count) {
+    buffer.append(count, ' ');
+}
+
+void OutputFrame::addTile(TileColour colour) {
+    buffer += Tile::getText(colour, coloured);
+}
+
+void OutputFrame::addTiles(TileColour colour, unsigned int count) {
+    const char* text = Tile::getText(colour, coloured);
+
+    for (unsigned int i = 0; i != count; ++i) {
+        buffer += text;
+    }
+}
+
+const char* OutputFrame::getData() {
+    return buffer.data();
+}
+
+size_t OutputFrame::getSize() {
+    return buffer.size();
+}
+
+string OutputFrame::toString() {
+    return buffer;
+}
@@ -0,0 +1,57 @@
+/*
+ * Output Frame
+ * 
+ * A whole screen of output, built up in a buffer the frame keeps between
+ * screens and printed with a single write, instead of a write and a new
+ * string for every line and tile. Tiles are drawn in colour only when the
+ * frame is going to a terminal, so logs and pipes get plain letters.
+ * 
+ * Authors: C. Hodgen (s3031209), J. Osrecak (s3782455)
+ */
+
+#ifndef OUTPUT_FRAME_H
+#define OUTPUT_FRAME_H
+
+#include <cstddef>
+#include <string>
+
+#include "Types.h"
+
+// Space set aside in a new frame, enough for a 4 player game with two centres
+#define OUTPUT_FRAME_RESERVE 4096
+
+class OutputFrame {
+    public:
+        OutputFrame(bool coloured);
+
+        // True if tiles are drawn with colour codes
+        bool isColoured();
+        void setColoured(bool coloured);
+
+        // Empty the frame, keeping its buffer
+        void clear();
+
+        void add(const char* text);
+        void add(const std::string& text);
+        void add(char c);
+        void add(int number);
+
+        // Add a number of spaces
+        void addSpaces(unsigned int count);
+
+        // Add one tile, or "-" for NONE
+        void addTile(TileColour colour);
+
+        // Add the same tile a number of times
+        void addTiles(TileColour colour, unsigned int count);
+
+        const char* getData();
+        size_t getSize();
+        std::string toString();
+
+    private:
+        std::string buffer;
+        bool coloured;
+};
+
+#endif // OUTPUT_FRAME_H
@@ -1,37 +1,32 @@
-
 #include <memory>
 #include <string>
-#include <vector>
 
 #include "PatternLine.h"
 #include "Tile.h"
 
-using std::move;
+using std::make_unique;
 using std::shared_ptr;
 using std::string;
 using std::unique_ptr;
-using std::vector;
 
 PatternLine::PatternLine(unsigned int size) :
-    size(size),
-    tiles(vector<unique_ptr<Tile>>())
+    size(size > MAX_LINE_SIZE ? MAX_LINE_SIZE : size),
+    count(0)
 {}
 
-PatternLine::~PatternLine() {
-    tiles.clear();
-}
+PatternLine::~PatternLine() {}
 
 unsigned int PatternLine::getSize() {
     return size;
 }
 
 int PatternLine::getSpace() {
-    return size - tiles.size();
+    return size - count;
 }
 
 int PatternLine::getNumberOfTiles()
 {
-    return tiles.size();
+    return count;
 }
 
 bool PatternLine::isfull() {
@@ -39,54 +34,85 @@ bool PatternLine::isfull() {
 }
 
 int PatternLine::addToWall(Mosaic& wall, int row, shared_ptr<BoxLid> lid) {
-    
+    TileColour colour = getColour();
+
     // Move a tile to the wall
-    int score = wall.add(move(tiles[0]), row);
+    int score = wall.add(colour, row);
     
     // Move remaining tiles to lid
-    for (unsigned int i = 1; i != size; ++i) {
-        lid->add(move(tiles[i]));
+    for (unsigned int i = 1; i < count; ++i) {
+        lid->add((TileColour) tiles[i]);
     }
 
+    clear();
+
     return score;
 }
 
 TileColour PatternLine::getColour() {
     TileColour colour = NONE;
 
-    if (tiles.size() != 0) {
-        colour = tiles[0]->getColour();
+    if (count != 0) {
+        colour = (TileColour) tiles[0];
     }
 
     return colour;
 }
 
 void PatternLine::addTile(unique_ptr<Tile> tile) {
-    if (tiles.size() != size) {
-        tiles.push_back(move(tile));
+    addTile(tile->getColour());
+}
+
+void PatternLine::addTile(TileColour colour) {
+    if (count != size) {
+        tiles[count] = (unsigned char) colour;
+        ++count;
+    }
+}
+
+unsigned int PatternLine::addTiles(TileColour colour, unsigned int number) {
+    while (number != 0 && count != size) {
+        tiles[count] = (unsigned char) colour;
+        ++count;
+        --number;
     }
+
+    return number;
 }
 
 unique_ptr<Tile> PatternLine::remove() {
-    // Get the tile from the end of the line
-    unique_ptr<Tile> tile = move(tiles[tiles.size() - 1]);
+    return make_unique<Tile>(removeTile());
+}
 
-    // Remove the tile's place on the vector, thus reducing its size
-    tiles.pop_back();
+TileColour PatternLine::removeTile() {
+    TileColour colour = NONE;
 
-    return tile;
+    // Take the tile from the end of the line
+    if (count != 0) {
+        --count;
+        colour = (TileColour) tiles[count];
+    }
+
+    return colour;
+}
+
+TileColour PatternLine::getTile(unsigned int index) {
+    TileColour colour = NONE;
+
+    if (index < count) {
+        colour = (TileColour) tiles[index];
+    }
+
+    return colour;
+}
+
+void PatternLine::clear() {
+    count = 0;
 }
 
 void PatternLine::reportTileCounts(std::map<TileColour, int>& tileCounts) {
-    for (unsigned int i = 0; i != tiles.size(); ++i) {
-        int newCount = 1;
-        auto count = tileCounts.find(tiles.at(i)->getColour());
-        
-        if (count != tileCounts.end()) {
-            newCount = count->second + 1;
-        } 
-
-        tileCounts[tiles.at(i)->getColour()] = newCount;
+    for (unsigned int i = 0; i != count; ++i) {
+        ++tileCounts[(TileColour) tiles[i]];
     }
 }
 
@@ -106,20 +132,10 @@ std::string PatternLine::toString() {
     return result;
 }
 
-std::string PatternLine::getPrintable()
+void PatternLine::print(OutputFrame& frame)
 {
-    string result = "";
     unsigned int space = getSpace();
-    TileColour colour = getColour();
-
-    for (unsigned int i = 0; i != size; ++i) {
-        if (i < space) {
-            result += Tile::colouredToString(NONE);
-        } else {
-            result += Tile::colouredToString(colour);
-            
-        }
-    }
 
-    return result;
+    frame.addTiles(NONE, space);
+    frame.addTiles(getColour(), size - space);
 }
@@ -1,4 +1,3 @@
-
 /*
  * Pattern Line
  * 
@@ -8,13 +7,18 @@
 #ifndef PATTERN_LINE_H
 #define PATTERN_LINE_H
 
+#include <map>
 #include <memory>
-#include <vector>
+#include <string>
 
 #include "BoxLid.h"
 #include "Mosaic.h"
+#include "OutputFrame.h"
 #include "Tile.h"
 
+// Largest line on a player board, the floor line
+#define MAX_LINE_SIZE   7
+
 class PatternLine {
     public:
         // Size is used to instantiate array should be between 1-5
@@ -42,22 +46,42 @@ class PatternLine {
         // need to be reinstantiated.
         void addTile(std::unique_ptr<Tile> tile);
 
+        // Add a tile of the given colour, if there is space for it
+        void addTile(TileColour colour);
+
+        // Add a number of tiles of one colour, and return how many did not fit
+        unsigned int addTiles(TileColour colour, unsigned int count);
+
         // Removes a tile from the line
         std::unique_ptr<Tile> remove();
 
+        // Removes a tile from the end of the line and returns its colour
+        TileColour removeTile();
+
+        // Returns the colour of the tile at index, where 0 was placed first
+        TileColour getTile(unsigned int index);
+
+        // Removes all tiles from the line
+        void clear();
+
         // Provide a breakdown of the tiles in a pattern line
         void reportTileCounts(std::map<TileColour, int>& tileCounts);
 
         // Get a printable string of the tile colours
         std::string toString();
-        //Returns a printable version containing coloured text
-        std::string getPrintable();
+        // Add the line to a screen, with "-" for each space
+        void print(OutputFrame& frame);
         //returns the number of tiles within the patternline
         int getNumberOfTiles();
 
     protected:
         unsigned int size;
-        std::vector<std::unique_ptr<Tile>> tiles;
+
+        // Colours of the tiles in the line, in the order they were placed
+        unsigned char tiles[MAX_LINE_SIZE];
+
+        // Number of tiles in the line
+        unsigned int count;
 
 };
 
@@ -0,0 +1,148 @@
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ModelBuilder.h"
+#include "Perft.h"
+
+using std::string;
+using std::thread;
+using std::vector;
+
+Perft::Perft(unsigned int numberOfThreads) :
+    numberOfThreads(numberOfThreads),
+    rootState(),
+    rootDepth(0)
+{
+    if (this->numberOfThreads == 0) {
+        this->numberOfThreads = thread::hardware_concurrency();
+    }
+    if (this->numberOfThreads == 0) {
+        this->numberOfThreads = 1;
+    }
+}
+
+unsigned long Perft::count(GameModel& gameModel, int depth) {
+    unsigned long total = 1;
+
+    gameModel.saveState(rootState);
+    rootDepth = depth;
+    rootMoves.clear();
+    rootCounts.clear();
+
+    if (depth > 0) {
+        MoveGenerator moveGenerator(gameModel);
+        Move moves[MAX_MOVES];
+        unsigned int numberOfMoves = moveGenerator.generate(moves);
+
+        rootMoves.assign(moves, moves + numberOfMoves);
+        rootCounts.assign(numberOfMoves, 0);
+
+        // Threads take the next root move as they finish the last
+        std::atomic<unsigned int> next(0);
+        vector<thread> workers;
+
+        for (unsigned int i = 0; i != numberOfThreads; ++i) {
+            workers.push_back(thread(&Perft::work, this, std::ref(next)));
+        }
+
+        for (thread& worker : workers) {
+            worker.join();
+        }
+
+        total = 0;
+        for (unsigned long leaves : rootCounts) {
+            total += leaves;
+        }
+    }
+
+    return total;
+}
+
+const vector<Move>& Perft::getRootMoves() {
+    return rootMoves;
+}
+
+const vector<unsigned long>& Perft::getRootCounts() {
+    return rootCounts;
+}
+
+void Perft::work(std::atomic<unsigned int>& next) {
+    // Each thread plays out moves on its own copy of the position
+    GameModel gameModel;
+    ModelBuilder(gameModel).loadState(rootState);
+    GameRules rules(gameModel);
+    MoveGenerator moveGenerator(gameModel);
+    unsigned int index = next++;
+
+    while (index < rootMoves.size()) {
+        if (rules.endsRound(rootMoves[index])) {
+            rootCounts[index] = 1;
+        } else {
+            rules.applyMove(rootMoves[index]);
+            rootCounts[index] = countLeaves(rules, moveGenerator, rootDepth - 1);
+            rules.undoMove();
+        }
+
+        index = next++;
+    }
+}
+
+unsigned long Perft::countLeaves(GameRules& rules, MoveGenerator& moveGenerator, int depth) {
+    unsigned long total = 1;
+
+    if (depth > 0) {
+        Move moves[MAX_MOVES];
+        unsigned int numberOfMoves = moveGenerator.generate(moves);
+
+        if (depth == 1) {
+            // Every move is a leaf, so there is no need to play them
+            total = numberOfMoves;
+        } else {
+            total = 0;
+
+            for (unsigned int i = 0; i != numberOfMoves; ++i) {
+                if (rules.endsRound(moves[i])) {
+                    total += 1;
+                } else {
+                    rules.applyMove(moves[i]);
+                    total += countLeaves(rules, moveGenerator, depth - 1);
+                    rules.undoMove();
+                }
+            }
+        }
+    }
+
+    return total;
+}
+
+string Perft::run(GameModel& gameModel, int depth) {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    unsigned long total = count(gameModel, depth);
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    double seconds = elapsed.count();
+
+    bool showCentre = gameModel.getNumberOfCentreFactories() == 2;
+    char line[160];
+    string result = "";
+
+    for (unsigned int i = 0; i != rootMoves.size(); ++i) {
+        snprintf(line, sizeof(line), "%-13s %lu\n",
+                 rootMoves[i].toString(showCentre && rootMoves[i].getSource() < CENTRE_SLOT_OFFSET).c_str(),
+                 rootCounts[i]);
+        result += line;
+    }
+
+    snprintf(line, sizeof(line), "\nDepth:          %d\n", depth);
+    result += line;
+    snprintf(line, sizeof(line), "Nodes:          %lu\n", total);
+    result += line;
+    snprintf(line, sizeof(line), "Time:           %.3fs on %u threads, %.0f nodes/sec\n",
+             seconds, numberOfThreads, seconds > 0 ? total / seconds : 0.0);
+    result += line;
+
+    return result;
+}
@@ -0,0 +1,59 @@
+/*
+ * Perft
+ * 
+ * Counts the lines of play from a position to a given number of moves,
+ * within the current round, as chess engines do to check and time their
+ * move generators. A move that ends the round is a leaf, however many
+ * moves were left to go.
+ * 
+ * Moves at the root are shared out between threads, each counting on its
+ * own copy of the position.
+ * 
+ * Authors: C. Hodgen (s3031209), J. Osrecak (s3782455)
+ */
+
+#ifndef PERFT_H
+#define PERFT_H
+
+#include <atomic>
+#include <string>
+#include <vector>
+
+#include "GameModel.h"
+#include "GameRules.h"
+#include "GameState.h"
+#include "Move.h"
+#include "MoveGenerator.h"
+
+class Perft {
+    public:
+        // Uses the given number of threads, or one per core for 0
+        Perft(unsigned int numberOfThreads);
+
+        // Number of leaves depth moves from the position, which is left
+        // unchanged
+        unsigned long count(GameModel& gameModel, int depth);
+
+        // Each move at the root of the last count, with its leaves
+        const std::vector<Move>& getRootMoves();
+        const std::vector<unsigned long>& getRootCounts();
+
+        // Count the leaves, timing it, and return a printable report
+        std::string run(GameModel& gameModel, int depth);
+
+    private:
+        unsigned int numberOfThreads;
+
+        GameState rootState;
+        int rootDepth;
+        std::vector<Move> rootMoves;
+        std::vector<unsigned long> rootCounts;
+
+        // Take root moves until there are none left
+        void work(std::atomic<unsigned int>& next);
+
+        // Leaves depth moves from the position
+        unsigned long countLeaves(GameRules& rules, MoveGenerator& moveGenerator, int depth);
+};
+
+#endif // PERFT_H
@@ -62,10 +62,23 @@ std::string Player::toString() {
     return data;
 }
 
-std::string Player::getPrintable() {
-    std::string data = "Name: " + name + ", ";
-    data += "Score: " + to_string(score) + "\n";
-    data += board->getPrintable();
+void Player::print(OutputFrame& frame) {
+    frame.add("Name: ");
+    frame.add(name);
+    frame.add(", Score: ");
+    frame.add(score);
+    frame.add('\n');
+    board->print(frame);
+}
 
-    return data;
+size_t Player::getMemoryUsage() {
+    size_t bytes = sizeof(Player) + SHARED_BLOCK_SIZE + board->getMemoryUsage();
+    const char* start = (const char*) &name;
+
+    // Short names are kept inside the string itself
+    if (name.data() < start || name.data() >= start + sizeof(name)) {
+        bytes += name.capacity() + 1;
+    }
+
+    return bytes;
 }
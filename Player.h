@@ -11,6 +11,7 @@
 #include <memory>
 #include <string>
 
+#include "OutputFrame.h"
 #include "PlayerBoard.h"
 
 class Player {
@@ -49,7 +50,11 @@ class Player {
         // Returns a string represenation of the player
         std::string toString();
 
-        std::string getPrintable();
+        // Add the player's name, score and board to a screen
+        void print(OutputFrame& frame);
+
+        // Estimated bytes held by the player, their name and their board
+        size_t getMemoryUsage();
 
     private:
         std::string name;
@@ -1,5 +1,6 @@
 
 #include <memory>
+#include <string>
 #include <vector>
 
 #include "FloorLine.h"
@@ -39,26 +40,38 @@ Mosaic& PlayerBoard::getMosaic() {
 }
 
 bool PlayerBoard::canAccept(TileColour colour, int row) {
-    bool result = false;
+    return (getAcceptMask(row) >> colour) & 1u;
+}
+
+unsigned int PlayerBoard::getAcceptMask(int row) {
+    unsigned int mask = (1u << NUMBER_OF_COLOURS) - 1;
     TileColour lineColour = lines[row]->getColour();
-    
+
     // The existing row must either match the colour or be empty
-    // And the corresponding row on the wall must not already contain this colour
-    if ((lineColour == colour || lineColour == NONE) && !wall.inRow(colour, row)) {
-        result = true;
+    if (lineColour != NONE) {
+        mask = 1u << lineColour;
     }
 
-    return result;
+    // And the corresponding row on the wall must not already contain this colour
+    return mask & ~wall.getRowColours(row);
 }
 
 void PlayerBoard::addTileToPatternLine(unique_ptr<Tile> tile, int row) {
     lines[row]->addTile(move(tile));
 }
 
+void PlayerBoard::addTileToPatternLine(TileColour colour, int row) {
+    lines[row]->addTile(colour);
+}
+
 void PlayerBoard::addTileToFloorLine(unique_ptr<Tile> tile) {
     floorLine->addTile(move(tile));
 }
 
+void PlayerBoard::addTileToFloorLine(TileColour colour) {
+    floorLine->addTile(colour);
+}
+
 void PlayerBoard::reportTileCounts(std::map<TileColour, int>& tileCounts) {
     for (shared_ptr<PatternLine> line : lines) {
         line->reportTileCounts(tileCounts);
@@ -97,26 +110,39 @@ string PlayerBoard::toString() {
 
 string PlayerBoard::getPrintable()
 {
-    string result = "";
+    OutputFrame frame(true);
+
+    print(frame);
 
+    return frame.toString();
+}
+
+void PlayerBoard::print(OutputFrame& frame)
+{
     for (int i = 0; i != 5; ++i) {
-        result += to_string(i + 1) + ": ";
+        frame.add(i + 1);
+        frame.add(": ");
 
         // Add pattern lines, with padding
-        string line = lines[i]->getPrintable();
-        result += line.insert(0, 5 - lines[i]->getSize(), ' ');
-        result += " || ";
+        frame.addSpaces(5 - lines[i]->getSize());
+        lines[i]->print(frame);
+        frame.add(" || ");
 
         // Add player's wall + template
-        result += wall.getPrintable(i);
+        wall.print(frame, i);
 
+        frame.add('\n');
+    }
 
+    frame.add("Floor: ");
+    floorLine->print(frame);
+}
 
-        result += "\n";
-    }
+size_t PlayerBoard::getMemoryUsage() {
+    size_t bytes = sizeof(PlayerBoard) + SHARED_BLOCK_SIZE + sizeof(FloorLine);
 
-    result += "Floor: ";
-    result += floorLine->getPrintable();
+    bytes += lines.capacity() * sizeof(shared_ptr<PatternLine>);
+    bytes += lines.size() * (SHARED_BLOCK_SIZE + sizeof(PatternLine));
 
-    return result;
-}
\ No newline at end of file
+    return bytes;
+}
@@ -9,9 +9,11 @@
 #define PLAYERBOARD_H
 
 #include <memory>
+#include <vector>
 
 #include "FloorLine.h"
 #include "Mosaic.h"
+#include "OutputFrame.h"
 #include "PatternLine.h"
 #include "Types.h"
 
@@ -29,6 +31,9 @@ class PlayerBoard {
         // Checks both the colour and mosaic template, to see if moving a tile
         // of the given colour is permitted
         bool canAccept(TileColour colour, int row);
+
+        // Mask of the colours a pattern line can accept, bit n for colour n
+        unsigned int getAcceptMask(int row);
         
         // Adds a tile to a pattern line on the specified row.
         // The caller of this method is responsible for ensuring there is
@@ -36,9 +41,15 @@ class PlayerBoard {
         // pointer will need to be reinstantiated.
         void addTileToPatternLine(std::unique_ptr<Tile> tile, int row);
 
+        // Adds a tile of the given colour to a pattern line, if there is room
+        void addTileToPatternLine(TileColour colour, int row);
+
         // Adds a tile to the floor line
         void addTileToFloorLine(std::unique_ptr<Tile> tile);
 
+        // Adds a tile of the given colour to the floor line, if there is room
+        void addTileToFloorLine(TileColour colour);
+
         // Provide a breakdown of the tiles on a board
         void reportTileCounts(std::map<TileColour, int>& tileCounts);
 
@@ -48,6 +59,12 @@ class PlayerBoard {
         //Returns a coloured printable version of the playerboard
         std::string getPrintable();
 
+        // Add the board to a screen
+        void print(OutputFrame& frame);
+
+        // Estimated bytes held by the board and the lines it owns
+        size_t getMemoryUsage();
+
     private:
         std::shared_ptr<FloorLine> floorLine;
         Mosaic wall;
@@ -0,0 +1,52 @@
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#include "AlphaBetaPolicy.h"
+#include "GreedyPolicy.h"
+#include "MctsPolicy.h"
+#include "Policy.h"
+#include "RandomPolicy.h"
+
+using std::make_shared;
+using std::shared_ptr;
+using std::string;
+
+Policy::~Policy() {}
+
+shared_ptr<Policy> Policy::create(const string& name, unsigned int seed) {
+    shared_ptr<Policy> policy = nullptr;
+
+    if (name == POLICY_RANDOM) {
+        policy = make_shared<RandomPolicy>(seed);
+    } else if (name == POLICY_GREEDY) {
+        policy = make_shared<GreedyPolicy>();
+    } else if (name == POLICY_MCTS) {
+        policy = make_shared<MctsPolicy>(seed, 0, 0, MCTS_DEFAULT_MILLISECONDS);
+    } else if (name.compare(0, POLICY_MCTS.size() + 1, POLICY_MCTS + ":") == 0) {
+        // A playout budget replaces the time budget
+        try {
+            unsigned long playouts = std::stoul(name.substr(POLICY_MCTS.size() + 1));
+
+            if (playouts != 0) {
+                policy = make_shared<MctsPolicy>(seed, 0, playouts, 0);
+            }
+        } catch (std::logic_error& e) {
+            // Not a number, so not a known policy
+        }
+    } else if (name == POLICY_ALPHABETA) {
+        policy = make_shared<AlphaBetaPolicy>(seed, ALPHA_BETA_DEFAULT_DEPTH, 0);
+    } else if (name.compare(0, POLICY_ALPHABETA.size() + 1, POLICY_ALPHABETA + ":") == 0) {
+        try {
+            int depth = std::stoi(name.substr(POLICY_ALPHABETA.size() + 1));
+
+            if (depth > 0) {
+                policy = make_shared<AlphaBetaPolicy>(seed, depth, 0);
+            }
+        } catch (std::logic_error& e) {
+            // Not a number, so not a known policy
+        }
+    }
+
+    return policy;
+}
@@ -0,0 +1,42 @@
+/*
+ * Policy
+ * 
+ * Chooses moves for a player without any input, so games can be played
+ * headless. Each policy is built by name: "random", "greedy", or "mcts",
+ * which may be followed by a playout budget e.g. "mcts:20000". A player
+ * whose name starts with BOT_NAME_PREFIX is played by the policy named by
+ * the rest of the name.
+ * 
+ * Authors: C. Hodgen (s3031209), J. Osrecak (s3782455)
+ */
+
+#ifndef POLICY_H
+#define POLICY_H
+
+#include <memory>
+#include <string>
+
+#include "GameModel.h"
+#include "Move.h"
+
+#define POLICY_RANDOM   std::string("random")
+#define POLICY_GREEDY   std::string("greedy")
+#define POLICY_MCTS     std::string("mcts")
+#define POLICY_ALPHABETA std::string("alphabeta")
+
+#define BOT_NAME_PREFIX std::string("bot:")
+
+class Policy {
+    public:
+        virtual ~Policy();
+
+        // Choose one of the legal moves for the current player. There is
+        // always at least one move to choose from.
+        virtual Move chooseMove(GameModel& gameModel, Move* moves, unsigned int numberOfMoves) = 0;
+
+        // Build a policy by name, using seed for any random choices. Returns
+        // nullptr if the name is not known.
+        static std::shared_ptr<Policy> create(const std::string& name, unsigned int seed);
+};
+
+#endif // POLICY_H
@@ -0,0 +1,13 @@
+#include <random>
+
+#include "RandomPolicy.h"
+
+RandomPolicy::RandomPolicy(unsigned int seed) :
+    engine(seed)
+{}
+
+Move RandomPolicy::chooseMove(GameModel& gameModel, Move* moves, unsigned int numberOfMoves) {
+    std::uniform_int_distribution<unsigned int> pick(0, numberOfMoves - 1);
+
+    return moves[pick(engine)];
+}
@@ -0,0 +1,26 @@
+/*
+ * Random Policy
+ * 
+ * Picks any legal move, with every move equally likely.
+ * 
+ * Authors: C. Hodgen (s3031209), J. Osrecak (s3782455)
+ */
+
+#ifndef RANDOM_POLICY_H
+#define RANDOM_POLICY_H
+
+#include <random>
+
+#include "Policy.h"
+
+class RandomPolicy : public Policy {
+    public:
+        RandomPolicy(unsigned int seed);
+
+        Move chooseMove(GameModel& gameModel, Move* moves, unsigned int numberOfMoves);
+
+    private:
+        std::mt19937 engine;
+};
+
+#endif // RANDOM_POLICY_H
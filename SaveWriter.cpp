@@ -0,0 +1,214 @@
+#include <cstring>
+#include <memory>
+#include <string>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "Mosaic.h"
+#include "Player.h"
+#include "SaveWriter.h"
+#include "Tile.h"
+
+using std::shared_ptr;
+using std::string;
+using std::to_string;
+using std::vector;
+
+SaveWriter::Keys::Keys() {
+    bag = BAG_KEY + KEY_VALUE_DELIMITER;
+    lid = LID_KEY + KEY_VALUE_DELIMITER;
+    table = TABLE_KEY + KEY_VALUE_DELIMITER;
+    currentPlayer = CURRENT_PLAYER_KEY + KEY_VALUE_DELIMITER;
+
+    for (int i = 0; i != MAX_STATE_CENTRES; ++i) {
+        centres[i] = FACTORY_KEY + KEY_SPLIT_DELIMITER + CENTRE_KEY + KEY_SPLIT_DELIMITER + to_string(i) + KEY_VALUE_DELIMITER;
+    }
+
+    for (int i = 0; i != MAX_STATE_FACTORIES; ++i) {
+        factories[i] = FACTORY_KEY + KEY_SPLIT_DELIMITER + to_string(i) + KEY_VALUE_DELIMITER;
+    }
+
+    for (int playerId = 0; playerId != MAX_STATE_PLAYERS; ++playerId) {
+        string prefix = PLAYER_KEY + KEY_SPLIT_DELIMITER + to_string(playerId) + KEY_SPLIT_DELIMITER;
+
+        names[playerId] = prefix + PLAYER_NAME_KEY + KEY_VALUE_DELIMITER;
+        scores[playerId] = prefix + PLAYER_SCORE_KEY + KEY_VALUE_DELIMITER;
+        floorLines[playerId] = prefix + PLAYER_FLOOR_KEY + KEY_VALUE_DELIMITER;
+
+        for (int row = 0; row != 5; ++row) {
+            patternLines[playerId][row] = prefix + PLAYER_PATTERN_KEY + KEY_SPLIT_DELIMITER + to_string(row) + KEY_VALUE_DELIMITER;
+            walls[playerId][row] = prefix + PLAYER_WALL_KEY + KEY_SPLIT_DELIMITER + to_string(row) + KEY_VALUE_DELIMITER;
+        }
+    }
+
+    for (int colour = 0; colour != NONE + 1; ++colour) {
+        tiles[colour] = Tile::toString((TileColour) colour)[0];
+    }
+
+    Mosaic mosaic;
+    for (int row = 0; row != 5; ++row) {
+        std::memcpy(wall[row], mosaic.toString(row, true).data(), 5);
+    }
+}
+
+const SaveWriter::Keys& SaveWriter::getKeys() {
+    // Built on first use, once for the whole program
+    static const Keys keys;
+    return keys;
+}
+
+SaveWriter::SaveWriter() {
+    buffer.reserve(SAVE_WRITER_RESERVE);
+}
+
+void SaveWriter::write(GameModel& gameModel) {
+    const Keys& keys = getKeys();
+    vector<shared_ptr<Player>>& players = gameModel.getAllPlayers();
+
+    gameModel.saveState(state);
+    buffer.clear();
+
+    // Bag and lid
+    buffer += keys.bag;
+    writeTiles(state.bag);
+    buffer += '\n';
+
+    buffer += keys.lid;
+    writeTiles(state.lid);
+    buffer += '\n';
+
+    for (unsigned int i = 0; i != state.numberOfCentres; ++i) {
+        buffer += keys.centres[i];
+        for (unsigned int colour = 0; colour != NUMBER_OF_COLOURS; ++colour) {
+            writeRun(keys.tiles[colour], state.centres[i][colour]);
+        }
+        buffer += '\n';
+    }
+
+    // The first player marker, if it has not been claimed
+    buffer += keys.table;
+    if (state.firstOnTable) {
+        buffer += keys.tiles[FIRST];
+    }
+    buffer += '\n';
+
+    for (unsigned int i = 0; i != state.numberOfFactories; ++i) {
+        buffer += keys.factories[i];
+        for (unsigned int colour = 0; colour != NUMBER_OF_COLOURS; ++colour) {
+            writeRun(keys.tiles[colour], state.getFactoryCount(i, (TileColour) colour));
+        }
+        buffer += '\n';
+    }
+
+    for (unsigned int playerId = 0; playerId != state.numberOfPlayers; ++playerId) {
+        const PlayerState& player = state.players[playerId];
+
+        buffer += keys.names[playerId];
+        buffer += players[playerId]->getName();
+        buffer += '\n';
+
+        buffer += keys.scores[playerId];
+        writeNumber(player.score);
+        buffer += '\n';
+
+        // Pattern lines fill from the right
+        for (int row = 0; row != 5; ++row) {
+            buffer += keys.patternLines[playerId][row];
+            writeRun(keys.tiles[NONE], row + 1 - player.lineCount[row]);
+            writeRun(keys.tiles[player.lineColour[row]], player.lineCount[row]);
+            buffer += '\n';
+        }
+
+        buffer += keys.floorLines[playerId];
+        for (unsigned int i = 0; i != player.floorCount; ++i) {
+            buffer += keys.tiles[player.floor[i]];
+        }
+        writeRun(keys.tiles[NONE], MAX_LINE_SIZE - player.floorCount);
+        buffer += '\n';
+
+        for (int row = 0; row != 5; ++row) {
+            buffer += keys.walls[playerId][row];
+            for (int column = 0; column != 5; ++column) {
+                buffer += (player.wall >> (row * 5 + column)) & 1u ? keys.wall[row][column] : keys.tiles[NONE];
+            }
+            buffer += '\n';
+        }
+    }
+
+    // The current player's id, or nothing if there is no current player
+    buffer += keys.currentPlayer;
+    for (unsigned int playerId = 0; playerId != state.numberOfPlayers; ++playerId) {
+        if (players[playerId] == gameModel.getCurrentPlayer()) {
+            writeNumber(playerId);
+        }
+    }
+    buffer += '\n';
+}
+
+const char* SaveWriter::getData() {
+    return buffer.data();
+}
+
+size_t SaveWriter::getSize() {
+    return buffer.size();
+}
+
+string SaveWriter::toString() {
+    return buffer;
+}
+
+bool SaveWriter::save(GameModel& gameModel, const string& fileName) {
+    bool saved = false;
+    write(gameModel);
+
+    int file = open(fileName.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+
+    if (file != -1) {
+        size_t written = 0;
+        ssize_t result = 1;
+
+        // A regular file takes the whole buffer at once, but a short write
+        // is still finished off rather than losing the end of the save
+        while (written != buffer.size() && result > 0) {
+            result = ::write(file, buffer.data() + written, buffer.size() - written);
+            if (result > 0) {
+                written += result;
+            }
+        }
+
+        saved = close(file) == 0 && written == buffer.size();
+    }
+
+    return saved;
+}
+
+void SaveWriter::writeTiles(const PackedTiles& tiles) {
+    const Keys& keys = getKeys();
+
+    for (unsigned int i = 0; i != tiles.length; ++i) {
+        buffer += keys.tiles[tiles.get(i)];
+    }
+}
+
+void SaveWriter::writeRun(char tile, unsigned int count) {
+    buffer.append(count, tile);
+}
+
+void SaveWriter::writeNumber(int number) {
+    char digits[12];
+    char* end = digits + sizeof(digits);
+    char* start = end;
+    unsigned int value = number < 0 ? 0u - number : number;
+
+    do {
+        *--start = '0' + value % 10;
+        value /= 10;
+    } while (value != 0);
+
+    if (number < 0) {
+        *--start = '-';
+    }
+
+    buffer.append(start, end - start);
+}
@@ -0,0 +1,81 @@
+/*
+ * Save Writer
+ * 
+ * Writes games in the text save format. Every key is built once, the first
+ * time a writer is made, including each player's and factory's, and a save
+ * is written straight into a buffer the writer keeps between saves, so
+ * saving the same game again costs no allocations. Files are written with a
+ * single write call.
+ * 
+ * Authors: C. Hodgen (s3031209), J. Osrecak (s3782455)
+ */
+
+#ifndef SAVE_WRITER_H
+#define SAVE_WRITER_H
+
+#include <cstddef>
+#include <string>
+
+#include "GameModel.h"
+#include "GameState.h"
+#include "Types.h"
+
+// Space set aside in a new writer, enough for any save with short names
+#define SAVE_WRITER_RESERVE 2048
+
+class SaveWriter {
+    public:
+        SaveWriter();
+
+        // Write a game into the buffer, replacing whatever was there
+        void write(GameModel& gameModel);
+
+        // The last game written
+        const char* getData();
+        size_t getSize();
+        std::string toString();
+
+        // Write a game to a file, overwriting it if it exists. Returns false
+        // if the file cannot be written.
+        bool save(GameModel& gameModel, const std::string& fileName);
+
+    private:
+        // Every key, with its delimiter, and the character for each tile
+        struct Keys {
+            std::string bag;
+            std::string lid;
+            std::string table;
+            std::string currentPlayer;
+            std::string centres[MAX_STATE_CENTRES];
+            std::string factories[MAX_STATE_FACTORIES];
+
+            std::string names[MAX_STATE_PLAYERS];
+            std::string scores[MAX_STATE_PLAYERS];
+            std::string patternLines[MAX_STATE_PLAYERS][5];
+            std::string floorLines[MAX_STATE_PLAYERS];
+            std::string walls[MAX_STATE_PLAYERS][5];
+
+            char tiles[NONE + 1];
+
+            // The colour belonging to each space of the wall
+            char wall[5][5];
+
+            Keys();
+        };
+
+        static const Keys& getKeys();
+
+        std::string buffer;
+
+        // Kept between saves so it is not remade each time
+        GameState state;
+
+        void writeTiles(const PackedTiles& tiles);
+
+        // Write a tile count times
+        void writeRun(char tile, unsigned int count);
+
+        void writeNumber(int number);
+};
+
+#endif // SAVE_WRITER_H
@@ -0,0 +1,215 @@
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "GameModel.h"
+#include "GameRules.h"
+#include "ModelBuilder.h"
+#include "MoveGenerator.h"
+#include "Policy.h"
+#include "Simulator.h"
+
+using std::shared_ptr;
+using std::string;
+using std::to_string;
+using std::vector;
+
+Simulator::Simulator(int numberOfPlayers, int numberOfCentres, const vector<string>& policyNames) :
+    numberOfPlayers(numberOfPlayers),
+    numberOfCentres(numberOfCentres)
+{
+    for (int i = 0; i != numberOfPlayers && !policyNames.empty(); ++i) {
+        this->policyNames.push_back(policyNames[i % policyNames.size()]);
+    }
+}
+
+bool Simulator::validate() {
+    bool valid = numberOfPlayers >= 2 && numberOfPlayers <= MAX_STATE_PLAYERS &&
+                 numberOfCentres >= 1 && numberOfCentres <= MAX_STATE_CENTRES &&
+                 (int) policyNames.size() == numberOfPlayers;
+
+    for (unsigned int i = 0; i != policyNames.size() && valid; ++i) {
+        valid = Policy::create(policyNames[i], 0) != nullptr;
+    }
+
+    return valid;
+}
+
+GameRecord Simulator::playGame(int seed) {
+    GameModel gameModel;
+    GameRules rules(gameModel);
+    MoveGenerator moveGenerator(gameModel);
+    Move moves[MAX_MOVES];
+
+    vector<string> names;
+    vector<shared_ptr<Policy>> policies;
+    for (int i = 0; i != numberOfPlayers; ++i) {
+        names.push_back("Player " + to_string(i + 1));
+        policies.push_back(Policy::create(policyNames[i], seed * MAX_STATE_PLAYERS + i));
+    }
+
+    ModelBuilder(gameModel).createNewGame(numberOfCentres, names.data(), numberOfPlayers, seed);
+    rules.startGame();
+
+    GameRecord record;
+    record.seed = seed;
+    record.rounds = 1;
+    record.completed = false;
+    record.conserved = true;
+
+    bool playing = true;
+    while (playing) {
+        unsigned int numberOfMoves = moveGenerator.generate(moves);
+
+        if (numberOfMoves == 0) {
+            // Every tile is stuck on the boards, so the game can't go on
+            playing = false;
+        } else {
+            shared_ptr<Policy> policy = policies[gameModel.getCurrentPlayerIndex()];
+            MoveResult result = rules.applyMove(policy->chooseMove(gameModel, moves, numberOfMoves));
+
+            // Nothing is ever taken back, so there is no need to keep
+            // the history
+            rules.clearHistory();
+
+            if (!gameModel.isConserved()) {
+                record.conserved = false;
+                playing = false;
+            } else if (result == ROUND_OVER) {
+                ++record.rounds;
+            } else if (result == GAME_OVER) {
+                record.completed = true;
+                playing = false;
+            }
+        }
+    }
+
+    record.winner = rules.getWinner();
+    for (int i = 0; i != MAX_STATE_PLAYERS; ++i) {
+        record.scores[i] = i < numberOfPlayers ? gameModel.getAllPlayers()[i]->getScore() : 0;
+    }
+
+    return record;
+}
+
+string Simulator::run(unsigned int numberOfGames, int baseSeed) {
+    vector<GameRecord> records;
+    records.reserve(numberOfGames);
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    for (unsigned int i = 0; i != numberOfGames; ++i) {
+        records.push_back(playGame(baseSeed + (int) i));
+    }
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    return getReport(records, elapsed.count());
+}
+
+string Simulator::getReport(const vector<GameRecord>& records, double seconds) {
+    unsigned int numberOfGames = records.size();
+    long totalRounds = 0;
+    int stalled = 0;
+    int defective = 0;
+    int draws = 0;
+    vector<int> wins(numberOfPlayers, 0);
+    vector<double> sums(numberOfPlayers, 0);
+    vector<double> squares(numberOfPlayers, 0);
+    vector<int> lowest(numberOfPlayers, 0);
+    vector<int> highest(numberOfPlayers, 0);
+    vector<int> buckets;
+
+    for (unsigned int i = 0; i != numberOfGames; ++i) {
+        const GameRecord& record = records[i];
+
+        totalRounds += record.rounds;
+        if (!record.conserved) {
+            ++defective;
+        } else if (!record.completed) {
+            ++stalled;
+        }
+
+        if (record.winner == -1) {
+            ++draws;
+        } else {
+            ++wins[record.winner];
+        }
+
+        for (int player = 0; player != numberOfPlayers; ++player) {
+            int score = record.scores[player];
+            unsigned int bucket = score / SCORE_BUCKET_SIZE;
+
+            sums[player] += score;
+            squares[player] += (double) score * score;
+            if (i == 0 || score < lowest[player]) {
+                lowest[player] = score;
+            }
+            if (i == 0 || score > highest[player]) {
+                highest[player] = score;
+            }
+
+            if (bucket >= buckets.size()) {
+                buckets.resize(bucket + 1, 0);
+            }
+            ++buckets[bucket];
+        }
+    }
+
+    char line[160];
+    string result = "";
+    double games = numberOfGames == 0 ? 1 : numberOfGames;
+
+    snprintf(line, sizeof(line), "Games:          %u (%d players, %d %s)\n",
+             numberOfGames, numberOfPlayers, numberOfCentres, numberOfCentres == 1 ? "centre" : "centres");
+    result += line;
+    snprintf(line, sizeof(line), "Time:           %.3fs, %.1f games/sec\n",
+             seconds, seconds > 0 ? numberOfGames / seconds : 0.0);
+    result += line;
+    snprintf(line, sizeof(line), "Average rounds: %.2f\n", totalRounds / games);
+    result += line;
+    snprintf(line, sizeof(line), "Draws:          %d\n", draws);
+    result += line;
+
+    if (stalled != 0) {
+        snprintf(line, sizeof(line), "Stalled:        %d\n", stalled);
+        result += line;
+    }
+
+    if (defective != 0) {
+        snprintf(line, sizeof(line), "Defective:      %d\n", defective);
+        result += line;
+    }
+
+    result += "\nPlayer  Policy    Wins    Mean   StdDev  Min  Max\n";
+    for (int player = 0; player != numberOfPlayers; ++player) {
+        double mean = sums[player] / games;
+        double variance = squares[player] / games - mean * mean;
+
+        snprintf(line, sizeof(line), "%-7d %-9s %-7d %-6.1f %-7.1f %-4d %d\n",
+                 player + 1, policyNames[player].c_str(), wins[player], mean,
+                 std::sqrt(variance > 0 ? variance : 0), lowest[player], highest[player]);
+        result += line;
+    }
+
+    // One bar per bucket, scaled so the longest is 50 wide
+    int mostScores = 1;
+    for (int count : buckets) {
+        if (count > mostScores) {
+            mostScores = count;
+        }
+    }
+
+    result += "\nScore distribution, all players\n";
+    for (unsigned int bucket = 0; bucket != buckets.size(); ++bucket) {
+        snprintf(line, sizeof(line), "%3u-%-3u %7d ", bucket * SCORE_BUCKET_SIZE,
+                 (bucket + 1) * SCORE_BUCKET_SIZE - 1, buckets[bucket]);
+        result += line;
+        result += string(buckets[bucket] * 50 / mostScores, '#') + "\n";
+    }
+
+    return result;
+}
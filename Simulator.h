@@ -0,0 +1,64 @@
+/*
+ * Simulator
+ * 
+ * Plays complete games between policies with no input or output, and
+ * reports on the results.
+ * 
+ * Authors: C. Hodgen (s3031209), J. Osrecak (s3782455)
+ */
+
+#ifndef SIMULATOR_H
+#define SIMULATOR_H
+
+#include <string>
+#include <vector>
+
+#include "GameState.h"
+
+// Width of each bar in the score distribution
+#define SCORE_BUCKET_SIZE   10
+
+// Outcome of one simulated game
+struct GameRecord {
+    int seed;
+    int rounds;
+
+    // Index of the winning player, or -1 for a draw
+    int winner;
+
+    // False if the game stopped because no move could be made
+    bool completed;
+
+    // False if the tiles stopped adding up, which stops the game
+    bool conserved;
+
+    int scores[MAX_STATE_PLAYERS];
+};
+
+class Simulator {
+    public:
+        // One policy name for each player. If there are fewer names than
+        // players, the names are repeated.
+        Simulator(int numberOfPlayers, int numberOfCentres, const std::vector<std::string>& policyNames);
+
+        // Check every policy name is known
+        bool validate();
+
+        // Play one game to the end, from a new game built with the seed
+        GameRecord playGame(int seed);
+
+        // Play a number of games with seeds counting up from baseSeed, and
+        // return a printable report
+        std::string run(unsigned int numberOfGames, int baseSeed);
+
+        // Build a printable report from a set of games, which took the given
+        // number of seconds to play
+        std::string getReport(const std::vector<GameRecord>& records, double seconds);
+
+    private:
+        int numberOfPlayers;
+        int numberOfCentres;
+        std::vector<std::string> policyNames;
+};
+
+#endif // SIMULATOR_H
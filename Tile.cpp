@@ -23,37 +23,23 @@ std::string Tile::toString(TileColour colour) {
 }
 
 std::string Tile::colouredToString(TileColour colour) {
+    return getText(colour, true);
+}
 
-    std::string str = "";
-    if(colourStrings[colour] == "R")
-    {
-        str = "\033[107;31mR\033[0;0m";
-    }
-    else if(colourStrings[colour] == "B")
-    {
-        str = "\033[107;34mB\033[0;0m";
-    }
-    else if(colourStrings[colour] == "Y")
-    {
-        str = "\033[107;33mY\033[0;0m";
-    }
-    else if(colourStrings[colour] == "U")
-    {
-        str = "\033[107;30mU\033[0;0m";
-    }
-    else if(colourStrings[colour] == "L")
-    {
-        str = "\033[107;94mL\033[0;0m";
-    }
-    else if(colourStrings[colour] == "F")
-    {
-        str= "\033[107;30mF\033[0;0m";
-    }
-    else
-    {
-        str = colourStrings[colour];
-    }
-    return str;
+const char* Tile::getText(TileColour colour, bool coloured) {
+    // By colour, in the order of TileColour
+    static const char* const colouredText[] = {
+        "\033[107;34mB\033[0;0m",
+        "\033[107;31mR\033[0;0m",
+        "\033[107;33mY\033[0;0m",
+        "\033[107;30mU\033[0;0m",
+        "\033[107;94mL\033[0;0m",
+        "\033[107;30mF\033[0;0m",
+        "-"
+    };
+    static const char* const plainText[] = { "B", "R", "Y", "U", "L", "F", "-" };
+
+    return coloured ? colouredText[colour] : plainText[colour];
 }
 
 Tile::Tile() :
@@ -92,35 +78,5 @@ std::string Tile::toString() {
 
 std::string Tile::colouredToString()
 {
-    std::string str = "";
-    
-    if(colourStrings[colour] == "R")
-    {
-        str = "\033[107;31mR\033[0;0m";
-    }
-    else if(colourStrings[colour] == "B")
-    {
-        str = "\033[107;34mB\033[0;0m";
-    }
-    else if(colourStrings[colour] == "Y")
-    {
-        str = "\033[107;33mY\033[0;0m";
-    }
-    else if(colourStrings[colour] == "U")
-    {
-        str = "\033[107;30mU\033[0;0m";
-    }
-    else if(colourStrings[colour] == "L")
-    {
-        str = "\033[107;94mL\033[0;0m";
-    }
-    else if(colourStrings[colour] == "F")
-    {
-        str= "\033[107;30mF\033[0;0m";
-    }
-    else
-    {
-        str = colourStrings[colour];
-    }
-    return str;
+    return colouredToString(colour);
 }
@@ -9,6 +9,7 @@
 #define TILE_H
 
 #include <map>
+#include <string>
 
 #include "Types.h"
 
@@ -36,6 +37,10 @@ class Tile {
         // Get the string for a specific colour.
         static std::string colouredToString(TileColour colour);
 
+        // The text printed for a colour, with or without colour codes.
+        // Looked up without making a string, for building screens.
+        static const char* getText(TileColour colour, bool coloured);
+
     private:
         TileColour colour;
 
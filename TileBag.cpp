@@ -1,59 +1,63 @@
-
 #include <map>
 #include <memory>
 
-#include "LinkedList.h"
 #include "TileBag.h"
+#include "TileQueue.h"
 
-using std::make_shared;
 using std::make_unique;
 using std::map;
 using std::unique_ptr;
 
 TileBag::TileBag() :
-    tiles(LinkedList())
+    tiles(TileQueue())
 {}
 
 unsigned int TileBag::getNumberOfTiles() {
     return tiles.size();
 }
 
-/* We're converting from unique to shared, so the underlying data structure
- * can freely copy items in its algorithms. That is to say, we are *trusting*
- * the linked list implementation to never make a duplicate tile and to never
- * lose a tile.
+unsigned int TileBag::getNumberOfTiles(TileColour colour) {
+    return tiles.count(colour);
+}
+
+/* Only the colour is kept, the tile object itself is released here. The queue
+ * is trusted to never duplicate or lose a colour.
  */
 void TileBag::add(unique_ptr<Tile> tile) {
-    tiles.addBack(make_shared<Tile>(Tile(*tile)));
+    tiles.push(tile->getColour());
+}
+
+void TileBag::add(TileColour colour) {
+    tiles.push(colour);
 }
 
 /* Convert back to a unique pointer to signal to the calling class that it is
  * now the owner of, and responsible for, the object.
  */
 unique_ptr<Tile> TileBag::remove() {
-    return make_unique<Tile>(*tiles.deleteFront());
+    return make_unique<Tile>(tiles.pop());
 }
 
-void TileBag::reportTileCounts(std::map<TileColour, int>& tileCounts) {
-    
-    for (unsigned int i = 0; i != tiles.size(); ++i) {
-        int newCount = 1;
-        
-        auto count = tileCounts.find(tiles.get(i)->getColour());
-        if (count != tileCounts.end()) {
-            newCount = count->second + 1;
-        } 
+TileColour TileBag::draw() {
+    return tiles.pop();
+}
 
-        tileCounts[tiles.get(i)->getColour()] = newCount;
-    }
+TileColour TileBag::getTile(unsigned int index) {
+    return tiles.get(index);
 }
 
-std::string TileBag::toString() {
-    std::string result = "";
+void TileBag::clear() {
+    tiles.clear();
+}
 
-    for (unsigned int i = 0; i != tiles.size(); ++i) {
-        result += tiles.get(i)->toString();
-    }
+void TileBag::shuffle(std::mt19937& engine) {
+    tiles.shuffle(engine);
+}
 
-    return result;
+void TileBag::reportTileCounts(std::map<TileColour, int>& tileCounts) {
+    tiles.reportTileCounts(tileCounts);
+}
+
+std::string TileBag::toString() {
+    return tiles.toString();
 }
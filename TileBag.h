@@ -1,4 +1,3 @@
-
 /*
  * Tile Bag
  * 
@@ -12,9 +11,10 @@
 
 #include <map>
 #include <memory>
+#include <random>
 
-#include "LinkedList.h"
 #include "Tile.h"
+#include "TileQueue.h"
 
 class TileBag {
     public:
@@ -23,12 +23,30 @@ class TileBag {
         // Return the number of tiles in the bag
         unsigned int getNumberOfTiles();
 
+        // Return the number of tiles of a colour in the bag
+        unsigned int getNumberOfTiles(TileColour colour);
+
         // Add a tile to the bag
         void add(std::unique_ptr<Tile> tile);
 
+        // Add a tile of the given colour to the bag
+        void add(TileColour colour);
+
         // Removes and returns a tile from the bag
         std::unique_ptr<Tile> remove();
 
+        // Removes a tile from the bag and returns its colour
+        TileColour draw();
+
+        // Returns the colour of the tile at index, where 0 is drawn next
+        TileColour getTile(unsigned int index);
+
+        // Removes every tile from the bag
+        void clear();
+
+        // Put the tiles in the bag in a random order
+        void shuffle(std::mt19937& engine);
+
         // Provide a breakdown of the tiles in the bag
         void reportTileCounts(std::map<TileColour, int>& tileCounts);
 
@@ -36,7 +54,7 @@ class TileBag {
         std::string toString();
 
     private:
-        LinkedList tiles;
+        TileQueue tiles;
 };
 
 #endif // TILE_BAG_H
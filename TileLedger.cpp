@@ -0,0 +1,117 @@
+#include <cstring>
+#include <memory>
+
+#include "BoxLid.h"
+#include "Factory.h"
+#include "GameModel.h"
+#include "Mosaic.h"
+#include "Player.h"
+#include "TileBag.h"
+#include "TileLedger.h"
+
+using std::shared_ptr;
+
+TileLedger::TileLedger() {
+    std::memset(counts, 0, sizeof(counts));
+    std::memset(locationCounts, 0, sizeof(locationCounts));
+    std::memset(colourCounts, 0, sizeof(colourCounts));
+    negatives = 0;
+}
+
+void TileLedger::move(TileLocation from, TileLocation to, TileColour colour, int count) {
+    if (count != 0) {
+        add(from, colour, -count);
+        add(to, colour, count);
+    }
+}
+
+int TileLedger::getCount(TileLocation location, TileColour colour) const {
+    return counts[location][colour];
+}
+
+int TileLedger::getCount(TileLocation location) const {
+    return locationCounts[location];
+}
+
+bool TileLedger::isBalanced() const {
+    bool balanced = negatives == 0 && colourCounts[FIRST] == LEDGER_FIRST_MARKERS;
+
+    for (int colour = 0; colour != NUMBER_OF_COLOURS; ++colour) {
+        balanced = balanced && colourCounts[colour] == LEDGER_TILES_PER_COLOUR;
+    }
+
+    return balanced;
+}
+
+void TileLedger::recount(GameModel& gameModel) {
+    *this = TileLedger();
+
+    shared_ptr<TileBag> bag = gameModel.getTileBag();
+    shared_ptr<BoxLid> lid = gameModel.getBoxLid();
+
+    for (int colour = 0; colour != NUMBER_OF_COLOURS; ++colour) {
+        add(LEDGER_BAG, (TileColour) colour, bag->getNumberOfTiles((TileColour) colour));
+        add(LEDGER_LID, (TileColour) colour, lid->getNumberOfTiles((TileColour) colour));
+    }
+
+    for (unsigned int i = 0; i != gameModel.getNumberOfFactories(); ++i) {
+        shared_ptr<Factory> factory = gameModel.getFactory(i);
+
+        for (int colour = 0; colour != NUMBER_OF_COLOURS; ++colour) {
+            add(LEDGER_FACTORIES, (TileColour) colour, factory->count((TileColour) colour));
+        }
+    }
+
+    for (int i = 0; i != gameModel.getNumberOfCentreFactories(); ++i) {
+        shared_ptr<Factory> centre = gameModel.getTableCentre(i);
+
+        for (int colour = 0; colour != NUMBER_OF_COLOURS; ++colour) {
+            add(LEDGER_CENTRES, (TileColour) colour, centre->count((TileColour) colour));
+        }
+    }
+
+    if (gameModel.isFirst()) {
+        add(LEDGER_TABLE, FIRST, 1);
+    }
+
+    for (const shared_ptr<Player>& player : gameModel.getAllPlayers()) {
+        shared_ptr<PlayerBoard> board = player->getBoard();
+        shared_ptr<FloorLine> floorLine = board->getFloorLine();
+        unsigned int wall = board->getMosaic().getWall();
+
+        for (int row = 0; row != 5; ++row) {
+            shared_ptr<PatternLine> line = board->getPatternLine(row);
+
+            if (line->getNumberOfTiles() != 0) {
+                add(LEDGER_PATTERN_LINES, line->getColour(), line->getNumberOfTiles());
+            }
+        }
+
+        for (int i = 0; i != floorLine->getNumberOfTiles(); ++i) {
+            add(LEDGER_FLOOR_LINES, floorLine->getTile(i), 1);
+        }
+
+        for (int colour = 0; colour != NUMBER_OF_COLOURS; ++colour) {
+            add(LEDGER_WALLS, (TileColour) colour, __builtin_popcount(wall & Mosaic::getColourMask((TileColour) colour)));
+        }
+    }
+}
+
+bool TileLedger::matches(GameModel& gameModel) const {
+    TileLedger fresh;
+    fresh.recount(gameModel);
+
+    return std::memcmp(counts, fresh.counts, sizeof(counts)) == 0;
+}
+
+void TileLedger::add(TileLocation location, TileColour colour, int count) {
+    int& current = counts[location][colour];
+    int before = current;
+
+    current += count;
+    locationCounts[location] += count;
+    colourCounts[colour] += count;
+
+    // Keep track of how many counts are negative as they cross zero
+    negatives += (current < 0) - (before < 0);
+}
@@ -0,0 +1,80 @@
+/*
+ * Tile Ledger
+ * 
+ * Running count of the tiles of each colour in each kind of place in the
+ * game, kept by the rules as tiles move, so that the 100 tiles and the first
+ * player marker can be checked for in constant time after every move rather
+ * than by recounting the whole game. Tiles only ever move from one place to
+ * another, so a count below zero or a colour total other than expected means
+ * the rules and the ledger have lost track of a tile.
+ * 
+ * Authors: C. Hodgen (s3031209), J. Osrecak (s3782455)
+ */
+
+#ifndef TILE_LEDGER_H
+#define TILE_LEDGER_H
+
+#include "Types.h"
+
+// Tiles of each colour in a full game, and first player markers
+#define LEDGER_TILES_PER_COLOUR 20
+#define LEDGER_FIRST_MARKERS    1
+
+// Places a tile can be. Factories, centres and each part of a board are
+// counted together across the game.
+enum TileLocation {
+    LEDGER_BAG,
+    LEDGER_LID,
+    LEDGER_FACTORIES,
+    LEDGER_CENTRES,
+    LEDGER_TABLE,
+    LEDGER_PATTERN_LINES,
+    LEDGER_FLOOR_LINES,
+    LEDGER_WALLS,
+    NUMBER_OF_LOCATIONS
+};
+
+class GameModel;
+
+class TileLedger {
+    public:
+        TileLedger();
+
+        // Move tiles of a colour from one place to another
+        void move(TileLocation from, TileLocation to, TileColour colour, int count);
+
+        // Tiles of a colour in a place
+        int getCount(TileLocation location, TileColour colour) const;
+
+        // Tiles of every colour in a place
+        int getCount(TileLocation location) const;
+
+        // True if no place holds a negative number of tiles, and there are
+        // the expected number of tiles of each colour and first player
+        // markers. Constant time.
+        bool isBalanced() const;
+
+        // Replace the counts with a count of the game as it is now
+        void recount(GameModel& gameModel);
+
+        // True if the counts are the same as a fresh count of the game.
+        // A slow cross-check of the moves recorded.
+        bool matches(GameModel& gameModel) const;
+
+    private:
+        // Counts by place and colour, including the first player marker
+        int counts[NUMBER_OF_LOCATIONS][NONE];
+
+        // Counts of all colours by place
+        int locationCounts[NUMBER_OF_LOCATIONS];
+
+        // Counts of each colour across every place
+        int colourCounts[NONE];
+
+        // Number of counts below zero
+        int negatives;
+
+        void add(TileLocation location, TileColour colour, int count);
+};
+
+#endif // TILE_LEDGER_H
@@ -0,0 +1,163 @@
+#include <map>
+#include <random>
+#include <string>
+
+#include "Tile.h"
+#include "TileQueue.h"
+
+using std::map;
+using std::string;
+
+TileQueue::TileQueue() :
+    head(0),
+    length(0)
+{
+    for (unsigned int i = 0; i != NUMBER_OF_COLOURS; ++i) {
+        counts[i] = 0;
+    }
+}
+
+unsigned int TileQueue::size() const {
+    return length;
+}
+
+unsigned int TileQueue::count(TileColour colour) const {
+    unsigned int result = 0;
+
+    if (colour < NUMBER_OF_COLOURS) {
+        result = counts[colour];
+    }
+
+    return result;
+}
+
+void TileQueue::push(TileColour colour) {
+    if (length != TILE_QUEUE_CAPACITY && colour < NUMBER_OF_COLOURS) {
+        unsigned int tail = head + length;
+
+        if (tail >= TILE_QUEUE_CAPACITY) {
+            tail -= TILE_QUEUE_CAPACITY;
+        }
+
+        tiles[tail] = (unsigned char) colour;
+        ++counts[colour];
+        ++length;
+    }
+}
+
+TileColour TileQueue::pop() {
+    TileColour colour = NONE;
+
+    if (length != 0) {
+        colour = (TileColour) tiles[head];
+        --counts[colour];
+        --length;
+
+        ++head;
+        if (head == TILE_QUEUE_CAPACITY) {
+            head = 0;
+        }
+    }
+
+    return colour;
+}
+
+TileColour TileQueue::popBack() {
+    TileColour colour = NONE;
+
+    if (length != 0) {
+        colour = get(length - 1);
+        --counts[colour];
+        --length;
+    }
+
+    return colour;
+}
+
+bool TileQueue::removeLast(TileColour colour) {
+    bool removed = false;
+    unsigned int index = length;
+
+    while (!removed && index != 0) {
+        --index;
+
+        if (get(index) == colour) {
+            removed = true;
+        }
+    }
+
+    if (removed) {
+        // Close the gap by moving the later tiles forward one place
+        for (unsigned int i = index; i + 1 < length; ++i) {
+            unsigned int position = head + i;
+
+            if (position >= TILE_QUEUE_CAPACITY) {
+                position -= TILE_QUEUE_CAPACITY;
+            }
+
+            tiles[position] = (unsigned char) get(i + 1);
+        }
+
+        --counts[colour];
+        --length;
+    }
+
+    return removed;
+}
+
+TileColour TileQueue::get(unsigned int index) const {
+    TileColour colour = NONE;
+
+    if (index < length) {
+        unsigned int position = head + index;
+
+        if (position >= TILE_QUEUE_CAPACITY) {
+            position -= TILE_QUEUE_CAPACITY;
+        }
+
+        colour = (TileColour) tiles[position];
+    }
+
+    return colour;
+}
+
+void TileQueue::clear() {
+    head = 0;
+    length = 0;
+
+    for (unsigned int i = 0; i != NUMBER_OF_COLOURS; ++i) {
+        counts[i] = 0;
+    }
+}
+
+void TileQueue::shuffle(std::mt19937& engine) {
+    // Fisher-Yates, working on positions relative to the front
+    for (unsigned int i = length; i > 1; --i) {
+        std::uniform_int_distribution<unsigned int> pick(0, i - 1);
+        unsigned int first = (head + i - 1) % TILE_QUEUE_CAPACITY;
+        unsigned int second = (head + pick(engine)) % TILE_QUEUE_CAPACITY;
+        unsigned char colour = tiles[first];
+
+        tiles[first] = tiles[second];
+        tiles[second] = colour;
+    }
+}
+
+void TileQueue::reportTileCounts(map<TileColour, int>& tileCounts) const {
+    for (unsigned int i = 0; i != NUMBER_OF_COLOURS; ++i) {
+        if (counts[i] != 0) {
+            tileCounts[(TileColour) i] += counts[i];
+        }
+    }
+}
+
+string TileQueue::toString() const {
+    string result = "";
+    result.reserve(length);
+
+    for (unsigned int i = 0; i != length; ++i) {
+        result += Tile::toString(get(i));
+    }
+
+    return result;
+}
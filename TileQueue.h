@@ -0,0 +1,78 @@
+/*
+ * Tile Queue
+ * 
+ * Fixed capacity, ordered collection of tile colours with running per-colour
+ * counts. Used for the bag and the lid, where draws come from the front and
+ * the order must be kept for save game fidelity. No heap allocation is made
+ * by any operation.
+ * 
+ * Authors: C. Hodgen (s3031209), J. Osrecak (s3782455)
+ */
+
+#ifndef TILE_QUEUE_H
+#define TILE_QUEUE_H
+
+#include <map>
+#include <random>
+#include <string>
+
+#include "Types.h"
+
+// Every tile in the game fits in a single queue
+#define TILE_QUEUE_CAPACITY 100
+
+class TileQueue {
+    public:
+        TileQueue();
+
+        // Return the number of tiles in the queue
+        unsigned int size() const;
+
+        // Return the number of tiles of a colour in the queue
+        unsigned int count(TileColour colour) const;
+
+        // Add a tile to the back of the queue. Ignored if the queue is full.
+        void push(TileColour colour);
+
+        // Remove and return the tile at the front of the queue, or NONE if
+        // the queue is empty
+        TileColour pop();
+
+        // Remove and return the tile at the back of the queue, or NONE if
+        // the queue is empty
+        TileColour popBack();
+
+        // Remove the tile of a colour nearest the back of the queue, keeping
+        // the order of the rest. Returns false if there is no such tile.
+        bool removeLast(TileColour colour);
+
+        // Return the tile at index, where 0 is the front of the queue
+        TileColour get(unsigned int index) const;
+
+        // Remove all tiles
+        void clear();
+
+        // Put the tiles in a random order
+        void shuffle(std::mt19937& engine);
+
+        // Provide a breakdown of the tiles in the queue
+        void reportTileCounts(std::map<TileColour, int>& tileCounts) const;
+
+        // Printable list of tiles, front to back
+        std::string toString() const;
+
+    private:
+        // Ring buffer of colours, stored as bytes
+        unsigned char tiles[TILE_QUEUE_CAPACITY];
+
+        // Position of the front of the queue in the ring buffer
+        unsigned int head;
+
+        // Number of tiles in the queue
+        unsigned int length;
+
+        // Running counts for each colour
+        unsigned int counts[NUMBER_OF_COLOURS];
+};
+
+#endif // TILE_QUEUE_H
@@ -0,0 +1,173 @@
+#include <chrono>
+#include <cstdio>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Tournament.h"
+
+using std::map;
+using std::string;
+using std::thread;
+using std::vector;
+
+Tournament::Tournament(int numberOfPlayers, int numberOfCentres, const vector<string>& policyNames) :
+    numberOfPlayers(numberOfPlayers),
+    numberOfCentres(numberOfCentres),
+    policyNames(policyNames)
+{
+    // Rotation r seats policy (seat + r) at each seat
+    for (int rotation = 0; rotation != numberOfPlayers && !policyNames.empty(); ++rotation) {
+        vector<string> seats;
+
+        for (int seat = 0; seat != numberOfPlayers; ++seat) {
+            seats.push_back(policyNames[(seat + rotation) % policyNames.size()]);
+        }
+
+        rotations.push_back(Simulator(numberOfPlayers, numberOfCentres, seats));
+    }
+}
+
+bool Tournament::validate() {
+    bool valid = !rotations.empty();
+
+    for (unsigned int i = 0; i != rotations.size() && valid; ++i) {
+        valid = rotations[i].validate();
+    }
+
+    return valid;
+}
+
+string Tournament::run(unsigned int numberOfSeeds, int baseSeed, unsigned int numberOfThreads) {
+    unsigned int numberOfGames = numberOfSeeds * rotations.size();
+
+    if (numberOfThreads == 0) {
+        numberOfThreads = thread::hardware_concurrency();
+    }
+    if (numberOfThreads == 0) {
+        numberOfThreads = 1;
+    }
+
+    // Start each thread with an even, contiguous share of the games
+    vector<WorkQueue> queues(numberOfThreads);
+    for (unsigned int game = 0; game != numberOfGames; ++game) {
+        queues[(unsigned long) game * numberOfThreads / numberOfGames].games.push_back(game);
+    }
+
+    vector<GameRecord> records(numberOfGames);
+    vector<thread> workers;
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    for (unsigned int worker = 0; worker != numberOfThreads; ++worker) {
+        workers.push_back(thread(&Tournament::work, this, worker, std::ref(queues),
+                                 std::ref(records), baseSeed));
+    }
+
+    for (thread& worker : workers) {
+        worker.join();
+    }
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    return getReport(records, elapsed.count(), numberOfThreads);
+}
+
+void Tournament::work(unsigned int worker, vector<WorkQueue>& queues,
+                      vector<GameRecord>& records, int baseSeed) {
+    unsigned int game = 0;
+
+    while (nextGame(worker, queues, game)) {
+        int seed = baseSeed + (int) (game / rotations.size());
+
+        // Each game has its own slot, so no other thread touches it
+        records[game] = rotations[game % rotations.size()].playGame(seed);
+    }
+}
+
+bool Tournament::nextGame(unsigned int worker, vector<WorkQueue>& queues, unsigned int& game) {
+    bool found = false;
+
+    {
+        std::lock_guard<std::mutex> guard(queues[worker].lock);
+
+        if (!queues[worker].games.empty()) {
+            game = queues[worker].games.back();
+            queues[worker].games.pop_back();
+            found = true;
+        }
+    }
+
+    // Games are never added, so once every queue has been seen empty
+    // there is nothing left to do
+    for (unsigned int i = 1; i != queues.size() && !found; ++i) {
+        WorkQueue& victim = queues[(worker + i) % queues.size()];
+        std::lock_guard<std::mutex> guard(victim.lock);
+
+        if (!victim.games.empty()) {
+            game = victim.games.front();
+            victim.games.pop_front();
+            found = true;
+        }
+    }
+
+    return found;
+}
+
+string Tournament::getReport(const vector<GameRecord>& records, double seconds, unsigned int numberOfThreads) {
+    // Totals for each distinct policy name
+    map<string, int> games;
+    map<string, int> wins;
+    map<string, int> draws;
+    map<string, double> scores;
+    long totalRounds = 0;
+
+    for (unsigned int game = 0; game != records.size(); ++game) {
+        const GameRecord& record = records[game];
+        unsigned int rotation = game % rotations.size();
+
+        totalRounds += record.rounds;
+
+        for (int seat = 0; seat != numberOfPlayers; ++seat) {
+            const string& policy = policyNames[(seat + rotation) % policyNames.size()];
+
+            ++games[policy];
+            scores[policy] += record.scores[seat];
+
+            if (record.winner == seat) {
+                ++wins[policy];
+            } else if (record.winner == -1) {
+                ++draws[policy];
+            }
+        }
+    }
+
+    char line[160];
+    string result = "";
+    double numberOfGames = records.empty() ? 1 : records.size();
+
+    snprintf(line, sizeof(line), "Games:          %u (%d players, %d %s, %u rotations)\n",
+             (unsigned int) records.size(), numberOfPlayers, numberOfCentres,
+             numberOfCentres == 1 ? "centre" : "centres", (unsigned int) rotations.size());
+    result += line;
+    snprintf(line, sizeof(line), "Time:           %.3fs on %u threads, %.1f games/sec\n",
+             seconds, numberOfThreads, seconds > 0 ? records.size() / seconds : 0.0);
+    result += line;
+    snprintf(line, sizeof(line), "Average rounds: %.2f\n", totalRounds / numberOfGames);
+    result += line;
+
+    result += "\nPolicy    Seats     Wins      Draws     Win%   Mean score\n";
+    for (auto& entry : games) {
+        const string& policy = entry.first;
+        int seats = entry.second;
+
+        snprintf(line, sizeof(line), "%-9s %-9d %-9d %-9d %-6.1f %.1f\n",
+                 policy.c_str(), seats, wins[policy], draws[policy],
+                 100.0 * wins[policy] / seats, scores[policy] / seats);
+        result += line;
+    }
+
+    return result;
+}
@@ -0,0 +1,64 @@
+/*
+ * Tournament
+ * 
+ * Plays a set of policies against each other over a range of seeds, spread
+ * across threads. Every seed is played once for each rotation of the
+ * policies around the table, so no policy gains from its seat.
+ * 
+ * Each thread owns a queue of games, taking work from its back and, once it
+ * runs out, stealing from the front of another thread's queue. Every game
+ * builds its own model, and writes its result into its own slot, so no lock
+ * is shared by all threads.
+ * 
+ * Authors: C. Hodgen (s3031209), J. Osrecak (s3782455)
+ */
+
+#ifndef TOURNAMENT_H
+#define TOURNAMENT_H
+
+#include <deque>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "Simulator.h"
+
+class Tournament {
+    public:
+        Tournament(int numberOfPlayers, int numberOfCentres, const std::vector<std::string>& policyNames);
+
+        // Check the players, centres and policy names are usable
+        bool validate();
+
+        // Play every rotation of the policies for each seed from baseSeed,
+        // using the given number of threads (0 for one per core), and
+        // return a printable report
+        std::string run(unsigned int numberOfSeeds, int baseSeed, unsigned int numberOfThreads);
+
+    private:
+        // Games waiting to be played by one thread, by index
+        struct WorkQueue {
+            std::mutex lock;
+            std::deque<unsigned int> games;
+        };
+
+        int numberOfPlayers;
+        int numberOfCentres;
+        std::vector<std::string> policyNames;
+
+        // One simulator for each rotation of the policies
+        std::vector<Simulator> rotations;
+
+        // Play games until every queue is empty
+        void work(unsigned int worker, std::vector<WorkQueue>& queues,
+                  std::vector<GameRecord>& records, int baseSeed);
+
+        // Take the next game for a worker, stealing if it has none left.
+        // Returns false once there are no games left anywhere.
+        bool nextGame(unsigned int worker, std::vector<WorkQueue>& queues, unsigned int& game);
+
+        // Build the report for every policy, from the results of every game
+        std::string getReport(const std::vector<GameRecord>& records, double seconds, unsigned int numberOfThreads);
+};
+
+#endif // TOURNAMENT_H
@@ -0,0 +1,51 @@
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include "TranspositionTable.h"
+
+TranspositionTable::TranspositionTable(unsigned int bits) :
+    slots((size_t) 1 << bits),
+    mask(((uint64_t) 1 << bits) - 1)
+{
+    clear();
+}
+
+bool TranspositionTable::probe(uint64_t key, TableEntry& entry) {
+    bool found = false;
+    Slot& slot = slots[key & mask];
+    uint64_t data = slot.data.load(std::memory_order_relaxed);
+    uint64_t check = slot.check.load(std::memory_order_relaxed);
+
+    // An empty slot has no data, so it can never match
+    if (data != 0 && (check ^ data) == key) {
+        entry.move = Move((uint16_t) (data & 0xFFFF));
+        entry.value = (int) (int16_t) ((data >> 16) & 0xFFFF);
+        entry.depth = (int) ((data >> 32) & 0xFF);
+        entry.bound = (int) ((data >> 40) & 0x3);
+        found = true;
+    }
+
+    return found;
+}
+
+void TranspositionTable::store(uint64_t key, const TableEntry& entry) {
+    Slot& slot = slots[key & mask];
+
+    // Bit 42 is always set, so stored data is never 0
+    uint64_t data = (uint64_t) entry.move.getValue() |
+                    ((uint64_t) (uint16_t) (int16_t) entry.value << 16) |
+                    ((uint64_t) (entry.depth & 0xFF) << 32) |
+                    ((uint64_t) (entry.bound & 0x3) << 40) |
+                    ((uint64_t) 1 << 42);
+
+    slot.check.store(key ^ data, std::memory_order_relaxed);
+    slot.data.store(data, std::memory_order_relaxed);
+}
+
+void TranspositionTable::clear() {
+    for (Slot& slot : slots) {
+        slot.check.store(0, std::memory_order_relaxed);
+        slot.data.store(0, std::memory_order_relaxed);
+    }
+}
@@ -0,0 +1,61 @@
+/*
+ * Transposition Table
+ * 
+ * Fixed size cache of search results, keyed by the Zobrist key of a
+ * position. Any number of threads may read and write it without a lock:
+ * each slot holds the data and the key XOR the data, so a slot torn by two
+ * writers fails the key check and reads as a miss.
+ * 
+ * Authors: C. Hodgen (s3031209), J. Osrecak (s3782455)
+ */
+
+#ifndef TRANSPOSITION_TABLE_H
+#define TRANSPOSITION_TABLE_H
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include "Move.h"
+
+// What a stored value says about the true value of the position
+#define BOUND_EXACT     0
+#define BOUND_LOWER     1
+#define BOUND_UPPER     2
+
+// Slots in a table by default, as a power of 2
+#define TRANSPOSITION_TABLE_BITS    20
+
+// One search result
+struct TableEntry {
+    int value;
+    int depth;
+    int bound;
+    Move move;
+};
+
+class TranspositionTable {
+    public:
+        // Table with 2^bits slots
+        TranspositionTable(unsigned int bits);
+
+        // Look up a position. Returns false if it is not in the table.
+        bool probe(uint64_t key, TableEntry& entry);
+
+        // Store a result for a position, replacing whatever shared its slot
+        void store(uint64_t key, const TableEntry& entry);
+
+        // Forget every result
+        void clear();
+
+    private:
+        struct Slot {
+            std::atomic<uint64_t> check;
+            std::atomic<uint64_t> data;
+        };
+
+        std::vector<Slot> slots;
+        uint64_t mask;
+};
+
+#endif // TRANSPOSITION_TABLE_H
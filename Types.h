@@ -8,8 +8,15 @@
 #ifndef TYPES_H
 #define TYPES_H
 
+// Number of colours that make up the 100 playing tiles
+#define NUMBER_OF_COLOURS   5
+
 // Tile Colours. First refers to the first token tile, must only be 1 first token,
 // whilst 20 of each of the others
+// Bytes of reference counts kept alongside each object made by
+// std::make_shared, for estimating memory use
+#define SHARED_BLOCK_SIZE   16
+
 enum TileColour {
     DARK_BLUE,
     RED,
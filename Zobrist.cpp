@@ -0,0 +1,239 @@
+#include <cstdint>
+
+#include "GameModel.h"
+#include "Zobrist.h"
+
+// Fixed seed, so keys are the same in every run and can be stored
+#define ZOBRIST_SEED 0x41A2B5C3D7E9F011ull
+
+uint64_t Zobrist::bagKeys[NUMBER_OF_COLOURS][ZOBRIST_MAX_COUNT + 1];
+uint64_t Zobrist::lidKeys[NUMBER_OF_COLOURS][ZOBRIST_MAX_COUNT + 1];
+uint64_t Zobrist::factoryKeys[ZOBRIST_SLOTS][NUMBER_OF_COLOURS][ZOBRIST_MAX_COUNT + 1];
+uint64_t Zobrist::lineKeys[ZOBRIST_MAX_PLAYERS][5][NUMBER_OF_COLOURS][6];
+uint64_t Zobrist::floorKeys[ZOBRIST_MAX_PLAYERS][MAX_LINE_SIZE][NUMBER_OF_COLOURS + 1];
+uint64_t Zobrist::wallKeys[ZOBRIST_MAX_PLAYERS][25];
+uint64_t Zobrist::scoreKeys[ZOBRIST_MAX_PLAYERS][ZOBRIST_SCORES];
+uint64_t Zobrist::firstKey;
+uint64_t Zobrist::toMoveKeys[ZOBRIST_MAX_PLAYERS];
+
+bool Zobrist::initialised = Zobrist::initialise();
+
+// splitmix64, small and good enough for filling key tables
+static uint64_t nextKey(uint64_t& state) {
+    uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+bool Zobrist::initialise() {
+    uint64_t state = ZOBRIST_SEED;
+
+    for (int colour = 0; colour != NUMBER_OF_COLOURS; ++colour) {
+        // A count of zero has no key, so empty locations cost nothing
+        bagKeys[colour][0] = 0;
+        lidKeys[colour][0] = 0;
+
+        for (int count = 1; count <= ZOBRIST_MAX_COUNT; ++count) {
+            bagKeys[colour][count] = nextKey(state);
+            lidKeys[colour][count] = nextKey(state);
+        }
+    }
+
+    for (int slot = 0; slot != ZOBRIST_SLOTS; ++slot) {
+        for (int colour = 0; colour != NUMBER_OF_COLOURS; ++colour) {
+            factoryKeys[slot][colour][0] = 0;
+
+            for (int count = 1; count <= ZOBRIST_MAX_COUNT; ++count) {
+                factoryKeys[slot][colour][count] = nextKey(state);
+            }
+        }
+    }
+
+    for (int player = 0; player != ZOBRIST_MAX_PLAYERS; ++player) {
+        for (int row = 0; row != 5; ++row) {
+            for (int colour = 0; colour != NUMBER_OF_COLOURS; ++colour) {
+                lineKeys[player][row][colour][0] = 0;
+
+                for (int count = 1; count != 6; ++count) {
+                    lineKeys[player][row][colour][count] = nextKey(state);
+                }
+            }
+        }
+
+        for (int slot = 0; slot != MAX_LINE_SIZE; ++slot) {
+            for (int colour = 0; colour != NUMBER_OF_COLOURS + 1; ++colour) {
+                floorKeys[player][slot][colour] = nextKey(state);
+            }
+        }
+
+        for (int space = 0; space != 25; ++space) {
+            wallKeys[player][space] = nextKey(state);
+        }
+
+        for (int score = 0; score != ZOBRIST_SCORES; ++score) {
+            scoreKeys[player][score] = nextKey(state);
+        }
+
+        toMoveKeys[player] = nextKey(state);
+    }
+
+    firstKey = nextKey(state);
+
+    return true;
+}
+
+uint64_t Zobrist::hash(GameModel& model) {
+    uint64_t key = bag(*model.getTileBag()) ^ lid(*model.getBoxLid()) ^ table(model);
+
+    for (int player = 0; player != model.getNumberOfPlayers(); ++player) {
+        std::shared_ptr<Player> current = model.getAllPlayers()[player];
+        std::shared_ptr<PlayerBoard> board = current->getBoard();
+
+        for (int row = 0; row != 5; ++row) {
+            key ^= patternLine(player, row, *board->getPatternLine(row));
+        }
+
+        key ^= floorLine(player, *board->getFloorLine());
+        key ^= wall(player, board->getMosaic().getWall());
+        key ^= score(player, current->getScore());
+    }
+
+    if (model.isFirst()) {
+        key ^= firstOnTable();
+    }
+
+    int current = model.getCurrentPlayerIndex();
+    if (current != -1) {
+        key ^= toMove(current);
+    }
+
+    return key;
+}
+
+uint64_t Zobrist::bagCount(TileColour colour, unsigned int count) {
+    return bagKeys[colour][count & ZOBRIST_MAX_COUNT];
+}
+
+uint64_t Zobrist::lidCount(TileColour colour, unsigned int count) {
+    return lidKeys[colour][count & ZOBRIST_MAX_COUNT];
+}
+
+uint64_t Zobrist::factoryCount(int slot, TileColour colour, unsigned int count) {
+    return factoryKeys[slot][colour][count & ZOBRIST_MAX_COUNT];
+}
+
+uint64_t Zobrist::bag(TileBag& bag) {
+    uint64_t key = 0;
+
+    for (int colour = 0; colour != NUMBER_OF_COLOURS; ++colour) {
+        key ^= bagCount((TileColour) colour, bag.getNumberOfTiles((TileColour) colour));
+    }
+
+    return key;
+}
+
+uint64_t Zobrist::lid(BoxLid& lid) {
+    uint64_t key = 0;
+
+    for (int colour = 0; colour != NUMBER_OF_COLOURS; ++colour) {
+        key ^= lidCount((TileColour) colour, lid.getNumberOfTiles((TileColour) colour));
+    }
+
+    return key;
+}
+
+uint64_t Zobrist::factory(int slot, Factory& factory) {
+    uint64_t key = 0;
+
+    for (int colour = 0; colour != NUMBER_OF_COLOURS; ++colour) {
+        key ^= factoryCount(slot, (TileColour) colour, factory.count((TileColour) colour));
+    }
+
+    return key;
+}
+
+uint64_t Zobrist::table(GameModel& model) {
+    uint64_t key = 0;
+
+    for (unsigned int i = 0; i != model.getNumberOfFactories(); ++i) {
+        key ^= factory(i, *model.getFactory(i));
+    }
+
+    for (int i = 0; i != model.getNumberOfCentreFactories(); ++i) {
+        key ^= factory(CENTRE_SLOT_OFFSET + i, *model.getTableCentre(i));
+    }
+
+    return key;
+}
+
+uint64_t Zobrist::unorderedTable(GameModel& model) {
+    uint64_t factories = 0;
+    uint64_t centres = 0;
+
+    // Every factory is keyed as if in the first factory slot, and every
+    // centre as if in the first centre slot
+    for (unsigned int i = 0; i != model.getNumberOfFactories(); ++i) {
+        factories += factory(0, *model.getFactory(i));
+    }
+
+    for (int i = 0; i != model.getNumberOfCentreFactories(); ++i) {
+        centres += factory(CENTRE_SLOT_OFFSET, *model.getTableCentre(i));
+    }
+
+    return factories ^ centres;
+}
+
+uint64_t Zobrist::patternLine(int player, int row, PatternLine& line) {
+    uint64_t key = 0;
+    TileColour colour = line.getColour();
+
+    if (colour < NUMBER_OF_COLOURS) {
+        key = lineKeys[player][row][colour][line.getNumberOfTiles()];
+    }
+
+    return key;
+}
+
+uint64_t Zobrist::floorLine(int player, PatternLine& line) {
+    uint64_t key = 0;
+    unsigned int count = line.getNumberOfTiles();
+
+    for (unsigned int i = 0; i != count; ++i) {
+        TileColour colour = line.getTile(i);
+
+        // The first player marker uses the extra colour slot
+        key ^= floorKeys[player][i][colour < NUMBER_OF_COLOURS ? colour : NUMBER_OF_COLOURS];
+    }
+
+    return key;
+}
+
+uint64_t Zobrist::wallSpace(int player, int space) {
+    return wallKeys[player][space];
+}
+
+uint64_t Zobrist::wall(int player, unsigned int wall) {
+    uint64_t key = 0;
+
+    while (wall != 0) {
+        key ^= wallKeys[player][__builtin_ctz(wall)];
+
+        // Clear the lowest set bit
+        wall &= wall - 1;
+    }
+
+    return key;
+}
+
+uint64_t Zobrist::score(int player, int score) {
+    return scoreKeys[player][(unsigned int) score % ZOBRIST_SCORES];
+}
+
+uint64_t Zobrist::firstOnTable() {
+    return firstKey;
+}
+
+uint64_t Zobrist::toMove(int player) {
+    return toMoveKeys[player];
+}
@@ -0,0 +1,110 @@
+/*
+ * Zobrist
+ * 
+ * 64 bit position keys. Each part of the game (a colour count in the bag, a
+ * tile in a floor line slot, a space on a wall, ...) has a fixed random key,
+ * and a position's key is the XOR of the keys of every part present. When a
+ * part changes, XOR out its old key and XOR in the new one, so the key can be
+ * kept up to date as the game is played rather than recomputed.
+ * 
+ * Keys for an empty count are zero, so empty locations cost nothing.
+ * 
+ * Authors: C. Hodgen (s3031209), J. Osrecak (s3782455)
+ */
+
+#ifndef ZOBRIST_H
+#define ZOBRIST_H
+
+#include <cstdint>
+
+#include "BoxLid.h"
+#include "Factory.h"
+#include "PatternLine.h"
+#include "TileBag.h"
+#include "TileQueue.h"
+
+class GameModel;
+
+#define ZOBRIST_MAX_PLAYERS 4
+
+// Factories use slots 0-8, the table centres use slots 9 and 10
+#define ZOBRIST_SLOTS       11
+
+// Largest count of a single colour in one location
+#define ZOBRIST_MAX_COUNT   31
+
+// Scores are keyed modulo this
+#define ZOBRIST_SCORES      256
+
+class Zobrist {
+    public:
+        // Compute the key of a whole game from scratch
+        static uint64_t hash(GameModel& model);
+
+        // Key for a colour count in the bag
+        static uint64_t bagCount(TileColour colour, unsigned int count);
+
+        // Key for a colour count in the lid
+        static uint64_t lidCount(TileColour colour, unsigned int count);
+
+        // Key for a colour count in a factory or centre slot
+        static uint64_t factoryCount(int slot, TileColour colour, unsigned int count);
+
+        // Key for the whole bag
+        static uint64_t bag(TileBag& bag);
+
+        // Key for the whole lid
+        static uint64_t lid(BoxLid& lid);
+
+        // Key for the whole of a factory or centre slot
+        static uint64_t factory(int slot, Factory& factory);
+
+        // Key for every factory and centre, each in its own slot
+        static uint64_t table(GameModel& model);
+
+        // Key for the factories and centres where only what they hold
+        // counts, not which slot holds it. Factories are interchangeable, as
+        // are the centres, so positions that differ only in their order
+        // play out the same way. Keys are added rather than XORed, so that
+        // two factories holding the same tiles do not cancel out.
+        static uint64_t unorderedTable(GameModel& model);
+
+        // Key for one of a player's pattern lines
+        static uint64_t patternLine(int player, int row, PatternLine& line);
+
+        // Key for a player's floor line
+        static uint64_t floorLine(int player, PatternLine& line);
+
+        // Key for a single occupied space on a player's wall
+        static uint64_t wallSpace(int player, int space);
+
+        // Key for a player's whole wall
+        static uint64_t wall(int player, unsigned int wall);
+
+        // Key for a player's score
+        static uint64_t score(int player, int score);
+
+        // Key for the first player marker sitting on the table
+        static uint64_t firstOnTable();
+
+        // Key for the player whose turn it is
+        static uint64_t toMove(int player);
+
+    private:
+        // Fill the tables, done once during static initialisation
+        static bool initialise();
+
+        static bool initialised;
+
+        static uint64_t bagKeys[NUMBER_OF_COLOURS][ZOBRIST_MAX_COUNT + 1];
+        static uint64_t lidKeys[NUMBER_OF_COLOURS][ZOBRIST_MAX_COUNT + 1];
+        static uint64_t factoryKeys[ZOBRIST_SLOTS][NUMBER_OF_COLOURS][ZOBRIST_MAX_COUNT + 1];
+        static uint64_t lineKeys[ZOBRIST_MAX_PLAYERS][5][NUMBER_OF_COLOURS][6];
+        static uint64_t floorKeys[ZOBRIST_MAX_PLAYERS][MAX_LINE_SIZE][NUMBER_OF_COLOURS + 1];
+        static uint64_t wallKeys[ZOBRIST_MAX_PLAYERS][25];
+        static uint64_t scoreKeys[ZOBRIST_MAX_PLAYERS][ZOBRIST_SCORES];
+        static uint64_t firstKey;
+        static uint64_t toMoveKeys[ZOBRIST_MAX_PLAYERS];
+};
+
+#endif // ZOBRIST_H
@@ -1,56 +1,314 @@
-
 /*
  * Main
- * 
+ *
  * Authors: C. Hodgen (s3031209), J. Osrecak (s3782455)
  */
 
 #include <iostream>
 #include <memory>
 #include <string>
+#include <vector>
 
+#include "BotProtocol.h"
+#include "CompactSave.h"
+#include "EndgameSolver.h"
 #include "GameEngine.h"
+#include "GameHost.h"
+#include "GameServer.h"
+#include "JournalReplay.h"
+#include "ModelBuilder.h"
+#include "Perft.h"
+#include "SaveWriter.h"
+#include "Simulator.h"
+#include "Tournament.h"
 
 class Args {
 public:
    bool haveSeed;
    int seed;
+
+   // Number of games to simulate, or 0 to play interactively
+   int simulate;
+
+   // Number of seeds to play a tournament over, or 0 for no tournament
+   int tournament;
+
+   // Threads for a tournament, or 0 for one per core
+   int threads;
+   int players;
+   int centres;
+   std::vector<std::string> policies;
+
+   // Save file to solve to the end of the game, or empty for none
+   std::string solveFile;
+
+   // Save file to count moves from, or empty for none, and how many
+   // moves deep to count
+   std::string perftFile;
+   int perftDepth;
+
+   // Save file to convert between text and compact form, and where to
+   // write it, or empty for none
+   std::string convertFrom;
+   std::string convertTo;
+
+   // Journal to rebuild a position from, or empty for none, and the number
+   // of moves to replay, or -1 for all of them
+   std::string replayFile;
+   int replayTurn;
+
+   // Journal to record interactive games in, or empty for none
+   std::string journalFile;
+
+   // Host many games by id, taking commands from stdin
+   bool host;
+
+   // Address to serve games on, or empty for none
+   std::string serveAddress;
+
+   // Answer JSON bot protocol requests from stdin
+   bool protocol;
 };
 
 void processArgs(int argc, char** argv, Args& args);
 
+// Split a comma separated list
+std::vector<std::string> splitList(const std::string& list);
+
+// Load a saved game, compact or text, returning false if it cannot be read
+// or is defective
+bool loadPosition(const std::string& fileName, GameModel& gameModel);
+
 int main(int argc, char** argv) {
+    int status = EXIT_SUCCESS;
+
     // Process the args
     Args args;
     processArgs(argc, argv, args);
 
-    GameEngine gameEngine;
+    if (!args.convertFrom.empty()) {
+        GameModel gameModel;
+        std::string& fileName = args.convertTo;
+        bool compact = fileName.size() >= COMPACT_SAVE_EXTENSION.size() &&
+                       fileName.compare(fileName.size() - COMPACT_SAVE_EXTENSION.size(),
+                                        COMPACT_SAVE_EXTENSION.size(), COMPACT_SAVE_EXTENSION) == 0;
 
-    if (args.haveSeed) {
-        gameEngine.setSeed(args.seed);
-    }
-    
-    // Print the welcome game banner
-    gameEngine.printBanner();
-    
-    // Start the primary game loop
-    gameEngine.run();
+        if (!loadPosition(args.convertFrom, gameModel)) {
+            std::cout << "Error: could not load " << args.convertFrom << "." << std::endl;
+            status = EXIT_FAILURE;
+        } else if (compact && !CompactSave::save(gameModel, fileName)) {
+            std::cout << "Error: could not write " << fileName << "." << std::endl;
+            status = EXIT_FAILURE;
+        } else if (!compact && !SaveWriter().save(gameModel, fileName)) {
+            std::cout << "Error: could not write " << fileName << "." << std::endl;
+            status = EXIT_FAILURE;
+        }
+    } else if (!args.replayFile.empty()) {
+        JournalReplay replay;
+        GameModel gameModel;
+
+        if (!replay.load(args.replayFile)) {
+            std::cout << "Error: could not read the journal " << args.replayFile << "." << std::endl;
+            status = EXIT_FAILURE;
+        } else {
+            unsigned int turn = args.replayTurn < 0 ? replay.getNumberOfMoves() : args.replayTurn;
+
+            if (!replay.seek(turn, gameModel)) {
+                std::cout << "Error: could not replay " << turn << " of the journal's "
+                          << replay.getNumberOfMoves() << " moves." << std::endl;
+                status = EXIT_FAILURE;
+            } else {
+                // Printed as a save, so it can be written straight to a file
+                std::cout << COMMENT_MARKER << " Turn " << turn << " of " << replay.getNumberOfMoves() << "\n"
+                          << gameModel.toString();
+            }
+        }
+    } else if (!args.perftFile.empty()) {
+        GameModel gameModel;
+
+        if (!loadPosition(args.perftFile, gameModel)) {
+            std::cout << "Error: could not load " << args.perftFile << "." << std::endl;
+            status = EXIT_FAILURE;
+        } else {
+            Perft perft(args.threads > 0 ? args.threads : 0);
+            std::cout << perft.run(gameModel, args.perftDepth);
+        }
+    } else if (!args.solveFile.empty()) {
+        GameModel gameModel;
+
+        if (!loadPosition(args.solveFile, gameModel)) {
+            std::cout << "Error: could not load " << args.solveFile << "." << std::endl;
+            status = EXIT_FAILURE;
+        } else if (!EndgameSolver::isSolvable(gameModel)) {
+            std::cout << "Error: the rest of the game depends on tiles not yet drawn." << std::endl;
+            status = EXIT_FAILURE;
+        } else {
+            EndgameSolver solver(args.threads > 0 ? args.threads : 0);
+            std::cout << solver.run(gameModel);
+        }
+    } else if (!args.serveAddress.empty()) {
+        GameServer gameServer(args.threads > 0 ? args.threads : 0);
 
-    // Display the exit credits
-    gameEngine.printCredits();
+        if (args.haveSeed) {
+            gameServer.setSeed(args.seed);
+        }
 
-    return EXIT_SUCCESS;
+        if (gameServer.listen(args.serveAddress)) {
+            gameServer.run();
+        } else {
+            std::cout << "Error: could not listen on " << args.serveAddress << "." << std::endl;
+            status = EXIT_FAILURE;
+        }
+    } else if (args.protocol) {
+        BotProtocol botProtocol;
+
+        if (args.haveSeed) {
+            botProtocol.setSeed(args.seed);
+        }
+
+        botProtocol.run();
+    } else if (args.host) {
+        GameHost gameHost;
+
+        if (args.haveSeed) {
+            gameHost.setSeed(args.seed, 1);
+        }
+
+        gameHost.run();
+    } else if (args.tournament > 0) {
+        Tournament tournament(args.players, args.centres, args.policies);
+
+        if (tournament.validate()) {
+            std::cout << tournament.run(args.tournament, args.haveSeed ? args.seed : 1,
+                                        args.threads > 0 ? args.threads : 0);
+        } else {
+            std::cout << "Error: tournament needs 2-4 players, 1-2 centres and "
+                      << "policies from: random, greedy, mcts[:playouts], alphabeta[:depth]." << std::endl;
+            status = EXIT_FAILURE;
+        }
+    } else if (args.simulate > 0) {
+        Simulator simulator(args.players, args.centres, args.policies);
+
+        if (simulator.validate()) {
+            std::cout << simulator.run(args.simulate, args.haveSeed ? args.seed : 1);
+        } else {
+            std::cout << "Error: simulation needs 2-4 players, 1-2 centres and "
+                      << "policies from: random, greedy, mcts[:playouts], alphabeta[:depth]." << std::endl;
+            status = EXIT_FAILURE;
+        }
+    } else {
+        GameEngine gameEngine;
+
+        if (args.haveSeed) {
+            gameEngine.setSeed(args.seed);
+        }
+
+        if (!args.journalFile.empty()) {
+            gameEngine.setJournal(args.journalFile);
+        }
+
+        // Print the welcome game banner
+        gameEngine.printBanner();
+
+        // Start the primary game loop
+        gameEngine.run();
+
+        // Display the exit credits
+        gameEngine.printCredits();
+    }
+
+    return status;
 }
 
 void processArgs(int argc, char** argv, Args& args) {
     args.haveSeed = false;
+    args.simulate = 0;
+    args.tournament = 0;
+    args.threads = 0;
+    args.players = 2;
+    args.centres = 1;
+    args.policies = splitList("random");
+    args.solveFile = "";
+    args.perftFile = "";
+    args.perftDepth = 0;
+    args.convertFrom = "";
+    args.convertTo = "";
+    args.replayFile = "";
+    args.replayTurn = -1;
+    args.journalFile = "";
+    args.host = false;
+    args.serveAddress = "";
+    args.protocol = false;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
 
-    if (argc >= 2) {
         try {
-            args.seed = std::stoi(argv[1]);
-            args.haveSeed = true;
-        } catch (std::invalid_argument& e) {
-            std::cout << "Warning: provided seed is not valid." << std::endl;
+            if (arg == "--simulate" && hasValue) {
+                args.simulate = std::stoi(argv[++i]);
+            } else if (arg == "--tournament" && hasValue) {
+                args.tournament = std::stoi(argv[++i]);
+            } else if (arg == "--threads" && hasValue) {
+                args.threads = std::stoi(argv[++i]);
+            } else if (arg == "--players" && hasValue) {
+                args.players = std::stoi(argv[++i]);
+            } else if (arg == "--centres" && hasValue) {
+                args.centres = std::stoi(argv[++i]);
+            } else if (arg == "--policy" && hasValue) {
+                args.policies = splitList(argv[++i]);
+            } else if (arg == "--perft" && i + 2 < argc) {
+                args.perftDepth = std::stoi(argv[i + 2]);
+                args.perftFile = argv[i + 1];
+                i += 2;
+            } else if (arg == "--convert" && i + 2 < argc) {
+                args.convertFrom = argv[i + 1];
+                args.convertTo = argv[i + 2];
+                i += 2;
+            } else if (arg == "--solve" && hasValue) {
+                args.solveFile = argv[++i];
+            } else if (arg == "--replay" && hasValue) {
+                args.replayFile = argv[++i];
+            } else if (arg == "--turn" && hasValue) {
+                args.replayTurn = std::stoi(argv[++i]);
+            } else if (arg == "--journal" && hasValue) {
+                args.journalFile = argv[++i];
+            } else if (arg == "--host") {
+                args.host = true;
+            } else if (arg == "--protocol") {
+                args.protocol = true;
+            } else if (arg == "--serve" && hasValue) {
+                args.serveAddress = argv[++i];
+            } else {
+                args.seed = std::stoi(arg);
+                args.haveSeed = true;
+            }
+        } catch (std::logic_error& e) {
+            if (arg.compare(0, 2, "--") == 0) {
+                std::cout << "Warning: value for " << arg << " is not valid." << std::endl;
+            } else {
+                std::cout << "Warning: provided seed is not valid." << std::endl;
+            }
         }
-    } 
+    }
+}
+
+std::vector<std::string> splitList(const std::string& list) {
+    std::vector<std::string> items;
+    std::string::size_type start = 0;
+    std::string::size_type end = list.find(',');
+
+    while (end != std::string::npos) {
+        items.push_back(list.substr(start, end - start));
+        start = end + 1;
+        end = list.find(',', start);
+    }
+
+    items.push_back(list.substr(start));
+
+    return items;
+}
+
+bool loadPosition(const std::string& fileName, GameModel& gameModel) {
+    return ModelBuilder(gameModel).loadSaveFile(fileName);
 }